@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Задача построения недельного расписания в плотных индексах, без зависимости от SC-memory.
+// Дни, типы смен и профессии задаются номерами 0 .. dayCount - 1, 0 .. shiftCount - 1, 0 .. professionCount - 1
+
+// Сотрудник (левая доля двудольного графа)
+struct ProblemEmployee
+{
+  size_t profession = 0;
+  std::vector<bool> availableShifts;  // availableShifts[shift] — может ли сотрудник работать в эту смену
+};
+
+// Слот смены (правая доля двудольного графа)
+struct ProblemSlot
+{
+  size_t day = 0;
+  size_t shift = 0;
+  size_t profession = 0;
+  int position = 0;  // Позиция в смене для нескольких сотрудников одной профессии
+};
+
+struct ScheduleProblem
+{
+  size_t dayCount = 0;
+  size_t shiftCount = 0;
+  size_t professionCount = 0;
+  int maxShiftsPerWeek = 5;  // Ограничение на число смен сотрудника; больше одной смены в день не назначается
+  std::vector<ProblemEmployee> employees;
+  std::vector<ProblemSlot> slots;
+};
+
+// Независимый блок паросочетания: сотрудники и слоты одной профессии
+struct ScheduleBlock
+{
+  size_t profession = 0;
+  std::vector<int> employees;
+  std::vector<int> slots;
+};
+
+struct ScheduleSolution
+{
+  std::vector<int> matching;   // Слот -> сотрудник (-1, если слот не занят)
+  std::vector<int> workloads;  // Сотрудник -> число назначенных смен
+};
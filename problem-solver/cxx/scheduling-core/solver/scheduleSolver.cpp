@@ -0,0 +1,185 @@
+#include "scheduleSolver.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+ScheduleSolver::ScheduleSolver(ScheduleProblem const & problem)
+  : m_problem(problem)
+{
+  Validate();
+  BuildAdjacency();
+  BuildBlocks();
+
+  m_solution.matching.assign(m_problem.slots.size(), -1);
+  m_solution.workloads.assign(m_problem.employees.size(), 0);
+  m_dayLoad.assign(m_problem.employees.size() * m_problem.dayCount, 0);
+  m_visited.assign(m_problem.slots.size(), 0);
+  m_onPath.assign(m_problem.employees.size(), 0);
+}
+
+void ScheduleSolver::Validate() const
+{
+  for (size_t i = 0; i < m_problem.employees.size(); ++i)
+  {
+    auto const & employee = m_problem.employees[i];
+    if (employee.profession >= m_problem.professionCount)
+      throw std::invalid_argument("Employee " + std::to_string(i) + " has unknown profession");
+    if (employee.availableShifts.size() != m_problem.shiftCount)
+      throw std::invalid_argument("Employee " + std::to_string(i) + " has wrong shift availability size");
+  }
+
+  for (size_t i = 0; i < m_problem.slots.size(); ++i)
+  {
+    auto const & slot = m_problem.slots[i];
+    if (slot.day >= m_problem.dayCount || slot.shift >= m_problem.shiftCount ||
+        slot.profession >= m_problem.professionCount)
+      throw std::invalid_argument("Slot " + std::to_string(i) + " is out of problem bounds");
+  }
+}
+
+void ScheduleSolver::BuildAdjacency()
+{
+  m_adjacency.assign(m_problem.employees.size(), {});
+
+  for (size_t empIdx = 0; empIdx < m_problem.employees.size(); ++empIdx)
+  {
+    auto const & employee = m_problem.employees[empIdx];
+    for (size_t slotIdx = 0; slotIdx < m_problem.slots.size(); ++slotIdx)
+    {
+      auto const & slot = m_problem.slots[slotIdx];
+      if (employee.profession == slot.profession && employee.availableShifts[slot.shift])
+        m_adjacency[empIdx].push_back(static_cast<int>(slotIdx));
+    }
+  }
+}
+
+// Сотрудники одной профессии могут занимать только слоты своей профессии,
+// поэтому паросочетание строится независимо для каждой профессии
+void ScheduleSolver::BuildBlocks()
+{
+  std::vector<ScheduleBlock> blocks(m_problem.professionCount);
+  for (size_t profession = 0; profession < blocks.size(); ++profession)
+    blocks[profession].profession = profession;
+
+  for (size_t empIdx = 0; empIdx < m_problem.employees.size(); ++empIdx)
+    blocks[m_problem.employees[empIdx].profession].employees.push_back(static_cast<int>(empIdx));
+  for (size_t slotIdx = 0; slotIdx < m_problem.slots.size(); ++slotIdx)
+    blocks[m_problem.slots[slotIdx].profession].slots.push_back(static_cast<int>(slotIdx));
+
+  for (auto & block : blocks)
+  {
+    if (!block.employees.empty() || !block.slots.empty())
+      m_blocks.push_back(std::move(block));
+  }
+}
+
+std::vector<ScheduleBlock> const & ScheduleSolver::GetBlocks() const
+{
+  return m_blocks;
+}
+
+size_t ScheduleSolver::GetEdgeCount() const
+{
+  size_t edgeCount = 0;
+  for (auto const & slots : m_adjacency)
+    edgeCount += slots.size();
+  return edgeCount;
+}
+
+ScheduleSolution const & ScheduleSolver::GetSolution() const
+{
+  return m_solution;
+}
+
+void ScheduleSolver::Assign(int slot, int employee)
+{
+  size_t const day = m_problem.slots[slot].day;
+  int const previous = m_solution.matching[slot];
+  if (previous != -1)
+  {
+    m_solution.workloads[previous]--;
+    m_dayLoad[previous * m_problem.dayCount + day]--;
+  }
+
+  m_solution.matching[slot] = employee;
+  m_solution.workloads[employee]++;
+  m_dayLoad[employee * m_problem.dayCount + day]++;
+}
+
+bool ScheduleSolver::TryKuhn(int employee)
+{
+  if (m_solution.workloads[employee] >= m_problem.maxShiftsPerWeek)
+    return false;
+
+  size_t const dayOffset = employee * m_problem.dayCount;
+  for (int slotIdx : m_adjacency[employee])
+  {
+    if (m_visited[slotIdx] == m_visitMark || m_dayLoad[dayOffset + m_problem.slots[slotIdx].day] > 0)
+      continue;
+
+    // Сотрудник уже на пути: повторный заход мог бы дать ему вторую смену в тот же день
+    int const current = m_solution.matching[slotIdx];
+    if (current != -1 && m_onPath[current])
+      continue;
+
+    m_visited[slotIdx] = m_visitMark;
+
+    m_onPath[employee] = 1;
+    bool const augmented = current == -1 || TryKuhn(current);
+    m_onPath[employee] = 0;
+
+    if (augmented)
+    {
+      Assign(slotIdx, employee);
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::vector<int> ScheduleSolver::GetEmployeeOrder(std::vector<int> const & employees) const
+{
+  std::vector<int> order = employees;
+  std::sort(order.begin(), order.end(), [this](int a, int b) {
+    return m_solution.workloads[a] < m_solution.workloads[b];
+  });
+  return order;
+}
+
+int ScheduleSolver::SolveBlock(ScheduleBlock const & block)
+{
+  bool improved = true;
+  int iteration = 0;
+
+  while (improved)
+  {
+    improved = false;
+    iteration++;
+
+    for (int empIdx : GetEmployeeOrder(block.employees))
+    {
+      if (m_solution.workloads[empIdx] < m_problem.maxShiftsPerWeek)
+      {
+        // Новая метка вместо очистки массива просмотренных слотов
+        if (++m_visitMark == 0)
+        {
+          std::fill(m_visited.begin(), m_visited.end(), 0);
+          m_visitMark = 1;
+        }
+        if (TryKuhn(empIdx))
+          improved = true;
+      }
+    }
+  }
+
+  return iteration;
+}
+
+ScheduleSolution const & ScheduleSolver::Solve()
+{
+  for (auto const & block : m_blocks)
+    SolveBlock(block);
+  return m_solution;
+}
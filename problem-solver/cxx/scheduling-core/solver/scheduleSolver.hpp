@@ -0,0 +1,45 @@
+#pragma once
+
+#include "scheduleProblem.hpp"
+
+#include <cstddef>
+#include <vector>
+
+// Решатель задачи расписания: максимальное паросочетание алгоритмом Куна с ограничениями
+// «не больше одной смены в день» и «не больше maxShiftsPerWeek смен в неделю».
+// Блоки разных профессий независимы: SolveBlock меняет только слоты и сотрудников своего блока,
+// поэтому готовые блоки можно читать из другого потока, пока решается следующий
+class ScheduleSolver
+{
+public:
+  // Задача должна существовать, пока существует решатель. При неверных индексах бросает std::invalid_argument
+  explicit ScheduleSolver(ScheduleProblem const & problem);
+
+  std::vector<ScheduleBlock> const & GetBlocks() const;
+  size_t GetEdgeCount() const;
+
+  // Возвращает число итераций до насыщения блока
+  int SolveBlock(ScheduleBlock const & block);
+  ScheduleSolution const & Solve();
+
+  ScheduleSolution const & GetSolution() const;
+
+private:
+  void Validate() const;
+  void BuildAdjacency();
+  void BuildBlocks();
+
+  bool TryKuhn(int employee);
+  void Assign(int slot, int employee);
+  std::vector<int> GetEmployeeOrder(std::vector<int> const & employees) const;
+
+  ScheduleProblem const & m_problem;
+  std::vector<std::vector<int>> m_adjacency;  // Списки смежности: сотрудник -> слоты
+  std::vector<ScheduleBlock> m_blocks;
+  ScheduleSolution m_solution;
+
+  std::vector<int> m_dayLoad;  // Число смен сотрудника в день: employee * dayCount + day
+  std::vector<unsigned> m_visited;  // Метка обхода слота; совпадение с m_visitMark — слот уже просмотрен
+  unsigned m_visitMark = 0;
+  std::vector<char> m_onPath;  // Сотрудники на текущем чередующемся пути
+};
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+
+#include "solver/scheduleSolver.hpp"
+
+#include <stdexcept>
+
+namespace
+{
+
+ScheduleProblem CreateProblem(size_t dayCount, size_t shiftCount, size_t professionCount, int maxShiftsPerWeek)
+{
+  ScheduleProblem problem;
+  problem.dayCount = dayCount;
+  problem.shiftCount = shiftCount;
+  problem.professionCount = professionCount;
+  problem.maxShiftsPerWeek = maxShiftsPerWeek;
+  return problem;
+}
+
+void AddEmployee(ScheduleProblem & problem, size_t profession, std::vector<bool> availableShifts = {})
+{
+  if (availableShifts.empty())
+    availableShifts.assign(problem.shiftCount, true);
+  problem.employees.push_back({profession, availableShifts});
+}
+
+// По одному слоту каждой профессии из professions на каждую смену каждого дня
+void AddSlots(ScheduleProblem & problem, std::vector<std::pair<size_t, int>> const & professions)
+{
+  for (size_t day = 0; day < problem.dayCount; ++day)
+  {
+    for (size_t shift = 0; shift < problem.shiftCount; ++shift)
+    {
+      for (auto const & [profession, count] : professions)
+      {
+        for (int position = 0; position < count; ++position)
+          problem.slots.push_back({day, shift, profession, position});
+      }
+    }
+  }
+}
+
+void ExpectConstraintsHold(ScheduleProblem const & problem, ScheduleSolution const & solution)
+{
+  std::vector<int> workloads(problem.employees.size(), 0);
+  std::vector<int> dayLoad(problem.employees.size() * problem.dayCount, 0);
+
+  for (size_t slotIdx = 0; slotIdx < solution.matching.size(); ++slotIdx)
+  {
+    int const employee = solution.matching[slotIdx];
+    if (employee == -1)
+      continue;
+
+    auto const & slot = problem.slots[slotIdx];
+    EXPECT_EQ(problem.employees[employee].profession, slot.profession);
+    EXPECT_TRUE(problem.employees[employee].availableShifts[slot.shift]);
+    workloads[employee]++;
+    EXPECT_LE(++dayLoad[employee * problem.dayCount + slot.day], 1);
+  }
+
+  EXPECT_EQ(workloads, solution.workloads);
+  for (int workload : workloads)
+    EXPECT_LE(workload, problem.maxShiftsPerWeek);
+}
+
+int CountFilled(ScheduleSolution const & solution)
+{
+  int filled = 0;
+  for (int employee : solution.matching)
+  {
+    if (employee != -1)
+      filled++;
+  }
+  return filled;
+}
+
+}  // namespace
+
+TEST(ScheduleSolverTest, Solve_FillsAllSlotsWhenFeasible)
+{
+  ScheduleProblem problem = CreateProblem(7, 1, 1, 5);
+  AddEmployee(problem, 0);
+  AddEmployee(problem, 0);
+  AddSlots(problem, {{0, 1}});
+
+  ScheduleSolver solver(problem);
+  ScheduleSolution const & solution = solver.Solve();
+
+  EXPECT_EQ(CountFilled(solution), 7);
+  ExpectConstraintsHold(problem, solution);
+}
+
+TEST(ScheduleSolverTest, Solve_OneShiftPerDayAndWeeklyLimit)
+{
+  ScheduleProblem problem = CreateProblem(7, 3, 1, 5);
+  AddEmployee(problem, 0);
+  AddSlots(problem, {{0, 1}});
+
+  ScheduleSolver solver(problem);
+  ScheduleSolution const & solution = solver.Solve();
+
+  EXPECT_EQ(CountFilled(solution), 5);
+  EXPECT_EQ(solution.workloads[0], 5);
+  ExpectConstraintsHold(problem, solution);
+}
+
+TEST(ScheduleSolverTest, Solve_RespectsShiftAvailability)
+{
+  ScheduleProblem problem = CreateProblem(2, 3, 1, 5);
+  AddEmployee(problem, 0, {false, false, true});
+  AddEmployee(problem, 0, {true, true, false});
+  AddSlots(problem, {{0, 1}});
+
+  ScheduleSolver solver(problem);
+  ScheduleSolution const & solution = solver.Solve();
+
+  // Ночные слоты занимает только первый сотрудник, по одному в день — второй
+  EXPECT_EQ(CountFilled(solution), 4);
+  ExpectConstraintsHold(problem, solution);
+}
+
+TEST(ScheduleSolverTest, Blocks_SplitByProfession)
+{
+  ScheduleProblem problem = CreateProblem(7, 3, 3, 5);
+  AddEmployee(problem, 2);
+  AddEmployee(problem, 0);
+  AddEmployee(problem, 2);
+  AddSlots(problem, {{0, 1}, {2, 2}});
+
+  ScheduleSolver solver(problem);
+  auto const & blocks = solver.GetBlocks();
+
+  ASSERT_EQ(blocks.size(), 2u);
+  EXPECT_EQ(blocks[0].profession, 0u);
+  EXPECT_EQ(blocks[0].employees, std::vector<int>({1}));
+  EXPECT_EQ(blocks[0].slots.size(), 21u);
+  EXPECT_EQ(blocks[1].profession, 2u);
+  EXPECT_EQ(blocks[1].employees, std::vector<int>({0, 2}));
+  EXPECT_EQ(blocks[1].slots.size(), 42u);
+  EXPECT_EQ(solver.GetEdgeCount(), 21u + 2 * 42u);
+
+  // Решение одного блока не затрагивает слоты другого
+  solver.SolveBlock(blocks[1]);
+  for (int slotIdx : blocks[0].slots)
+    EXPECT_EQ(solver.GetSolution().matching[slotIdx], -1);
+  ExpectConstraintsHold(problem, solver.GetSolution());
+}
+
+TEST(ScheduleSolverTest, Constructor_RejectsOutOfRangeIds)
+{
+  ScheduleProblem problem = CreateProblem(7, 3, 1, 5);
+  AddEmployee(problem, 0);
+  problem.slots.push_back({7, 0, 0, 0});
+  EXPECT_THROW(ScheduleSolver solver(problem), std::invalid_argument);
+
+  problem.slots.clear();
+  problem.employees.push_back({1, {true, true, true}});
+  EXPECT_THROW(ScheduleSolver solver(problem), std::invalid_argument);
+}
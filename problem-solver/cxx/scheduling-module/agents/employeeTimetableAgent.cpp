@@ -0,0 +1,78 @@
+#include "employeeTimetableAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+
+#include <sc-memory/sc_memory_headers.hpp>
+
+ScAddr EmployeeTimetableAgent::GetActionClass() const
+{
+  return SchedulingKeynodes::action_get_employee_timetable;
+}
+
+// Графиков у сотрудника столько, сколько хранится расписаний, поэтому поиск не зависит от размера штата
+ScAddr EmployeeTimetableAgent::FindTimetable(ScAddr const & employee, ScAddr const & schedule)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      ScType::ConstNode, ScType::ConstCommonArc, employee, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_timetable_employee);
+  while (it->Next())
+  {
+    ScAddr timetable = it->Get(0);
+    if (m_context.CheckConnector(schedule, timetable, ScType::ConstPermPosArc))
+      return timetable;
+  }
+  return ScAddr::Empty;
+}
+
+// Во время переключения current_schedule может содержать два расписания — оба построены целиком
+ScAddr EmployeeTimetableAgent::GetCurrentSchedule()
+{
+  ScIterator3Ptr it = m_context.CreateIterator3(
+      SchedulingKeynodes::current_schedule, ScType::ConstPermPosArc, ScType::ConstNodeStructure);
+  while (it->Next())
+  {
+    if (m_context.CheckConnector(SchedulingKeynodes::concept_schedule, it->Get(2), ScType::ConstPermPosArc))
+      return it->Get(2);
+  }
+  return ScAddr::Empty;
+}
+
+ScResult EmployeeTimetableAgent::DoProgram(ScAction & action)
+{
+  auto const & [employee, scheduleArgument] = action.GetArguments<2>();
+  if (!employee.IsValid())
+  {
+    m_logger.Error("EmployeeTimetableAgent: Employee must be provided");
+    return action.FinishWithError();
+  }
+
+  // Без явного расписания график берётся из текущего опубликованного
+  ScAddr const schedule = scheduleArgument.IsValid() ? scheduleArgument : GetCurrentSchedule();
+  if (!schedule.IsValid())
+  {
+    m_logger.Warning("EmployeeTimetableAgent: No schedule has been published yet");
+    return action.FinishUnsuccessfully();
+  }
+
+  ScAddr timetable = FindTimetable(employee, schedule);
+  if (!timetable.IsValid())
+  {
+    m_logger.Warning("EmployeeTimetableAgent: Schedule has no timetable for the employee");
+    return action.FinishUnsuccessfully();
+  }
+
+  ScStructure result = m_context.GenerateStructure();
+  result << timetable;
+
+  ScIterator5Ptr itMask = m_context.CreateIterator5(
+      timetable, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_shift_mask);
+  if (itMask->Next())
+    result << itMask->Get(1) << itMask->Get(2);
+
+  ScIterator3Ptr itAssignment = m_context.CreateIterator3(timetable, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (itAssignment->Next())
+    result << itAssignment->Get(2);
+
+  action.SetResult(result);
+  return action.FinishSuccessfully();
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <sc-memory/sc_agent.hpp>
+
+// Возвращает недельный график сотрудника: маску смен 7×3 и его назначения
+class EmployeeTimetableAgent : public ScActionInitiatedAgent
+{
+public:
+  ScAddr GetActionClass() const override;
+  ScResult DoProgram(ScAction & action) override;
+
+private:
+  ScAddr GetCurrentSchedule();
+  ScAddr FindTimetable(ScAddr const & employee, ScAddr const & schedule);
+};
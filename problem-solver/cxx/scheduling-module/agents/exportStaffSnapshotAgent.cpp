@@ -0,0 +1,141 @@
+#include "exportStaffSnapshotAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/scheduleCodes.hpp"
+
+#include <sc-memory/sc_memory_headers.hpp>
+
+#include <fstream>
+
+ScAddr ExportStaffSnapshotAgent::GetActionClass() const
+{
+  return SchedulingKeynodes::action_export_staff_snapshot;
+}
+
+std::string ExportStaffSnapshotAgent::GetLinkString(ScAddr const & link)
+{
+  std::string content;
+  if (link.IsValid() && m_context.GetElementType(link).IsLink())
+    m_context.GetLinkContent(link, content);
+  return content;
+}
+
+std::string ExportStaffSnapshotAgent::GetAttributeContent(ScAddr const & element, ScAddr const & relation)
+{
+  std::string content;
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      element, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc, relation);
+  if (it->Next())
+    m_context.GetLinkContent(it->Get(2), content);
+  return content;
+}
+
+bool ExportStaffSnapshotAgent::GetDictionaryIndex(
+    ScAddr const & classAddr, std::vector<std::string> & dictionary, DictionaryIndex & index, uint32_t & position)
+{
+  auto const it = index.find(classAddr);
+  if (it != index.cend())
+  {
+    position = it->second;
+    return true;
+  }
+
+  std::string const identifier = m_context.GetElementSystemIdentifier(classAddr);
+  if (identifier.empty())
+    return false;
+
+  position = static_cast<uint32_t>(dictionary.size());
+  dictionary.push_back(identifier);
+  index.emplace(classAddr, position);
+  return true;
+}
+
+std::vector<uint32_t> ExportStaffSnapshotAgent::CollectShifts(
+    ScAddr const & employee, ScAddr const & relation, StaffSnapshot & snapshot, DictionaryIndex & shiftIndex)
+{
+  std::vector<uint32_t> shifts;
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      employee, ScType::ConstCommonArc, ScType::ConstNode, ScType::ConstPermPosArc, relation);
+  while (it->Next())
+  {
+    uint32_t position = 0;
+    if (GetDictionaryIndex(it->Get(2), snapshot.shifts, shiftIndex, position))
+      shifts.push_back(position);
+  }
+  return shifts;
+}
+
+// Переносятся члены concept_employee; сотрудник без профессии из кодовой таблицы пропускается
+StaffSnapshot ExportStaffSnapshotAgent::CollectStaff(size_t & skipped)
+{
+  auto const professionMap = ScheduleCodes::LoadProfessionMap(m_context);
+  ScAddrUnorderedSet const professions(professionMap.GetClasses().cbegin(), professionMap.GetClasses().cend());
+
+  StaffSnapshot snapshot;
+  DictionaryIndex professionIndex;
+  DictionaryIndex shiftIndex;
+
+  ScIterator3Ptr itEmployee = m_context.CreateIterator3(
+      SchedulingKeynodes::concept_employee, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (itEmployee->Next())
+  {
+    ScAddr const employee = itEmployee->Get(2);
+
+    StaffSnapshotEmployee record;
+    bool hasProfession = false;
+    ScIterator3Ptr itClass = m_context.CreateIterator3(ScType::ConstNodeClass, ScType::ConstPermPosArc, employee);
+    while (!hasProfession && itClass->Next())
+    {
+      hasProfession = professions.count(itClass->Get(0)) > 0
+                      && GetDictionaryIndex(itClass->Get(0), snapshot.professions, professionIndex, record.profession);
+    }
+    if (!hasProfession)
+    {
+      skipped++;
+      continue;
+    }
+
+    record.id = GetAttributeContent(employee, SchedulingKeynodes::nrel_employee_id);
+    record.name = GetAttributeContent(employee, ScKeynodes::nrel_main_idtf);
+    record.allowedShifts = CollectShifts(employee, SchedulingKeynodes::nrel_allowed_shift, snapshot, shiftIndex);
+    record.forbiddenShifts = CollectShifts(employee, SchedulingKeynodes::nrel_can_not_work, snapshot, shiftIndex);
+    snapshot.employees.push_back(std::move(record));
+  }
+  return snapshot;
+}
+
+ScResult ExportStaffSnapshotAgent::DoProgram(ScAction & action)
+{
+  auto const & [filePathLink] = action.GetArguments<1>();
+
+  size_t skipped = 0;
+  StaffSnapshot const snapshot = CollectStaff(skipped);
+  if (skipped > 0)
+    m_logger.Warning("ExportStaffSnapshotAgent: Employees without known profession skipped: ", skipped);
+
+  std::string const data = StaffSnapshotCodec::Encode(snapshot);
+  ScStructure result = m_context.GenerateStructure();
+  std::string const filePath = GetLinkString(filePathLink);
+
+  if (!filePath.empty())
+  {
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    if (!file)
+    {
+      m_logger.Error("ExportStaffSnapshotAgent: Failed to write file ", filePath);
+      return action.FinishWithError();
+    }
+    result << filePathLink;
+  }
+  else
+  {
+    ScAddr link = m_context.GenerateLink(ScType::ConstNodeLink);
+    m_context.SetLinkContent(link, data);
+    result << link;
+  }
+
+  m_logger.Info(
+      "ExportStaffSnapshotAgent: Exported ", snapshot.employees.size(), " employees, ", data.size(), " bytes");
+  action.SetResult(result);
+  return action.FinishSuccessfully();
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <sc-memory/sc_agent.hpp>
+
+#include "utils/staffSnapshot.hpp"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Сохраняет текущий штат (имена, идентификаторы, профессии и ограничения смен) в двоичный снимок
+// в локальный файл или sc-ссылку. Снимок загружается агентом ImportStaffFromSnapshotAgent
+class ExportStaffSnapshotAgent : public ScActionInitiatedAgent
+{
+public:
+  ScAddr GetActionClass() const override;
+  ScResult DoProgram(ScAction & action) override;
+
+private:
+  using DictionaryIndex = std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc>;
+
+  std::string GetLinkString(ScAddr const & link);
+  std::string GetAttributeContent(ScAddr const & element, ScAddr const & relation);
+
+  // Номер класса в словаре снимка; класс без системного идентификатора не переносится
+  bool GetDictionaryIndex(
+      ScAddr const & classAddr,
+      std::vector<std::string> & dictionary,
+      DictionaryIndex & index,
+      uint32_t & position);
+
+  std::vector<uint32_t> CollectShifts(
+      ScAddr const & employee,
+      ScAddr const & relation,
+      StaffSnapshot & snapshot,
+      DictionaryIndex & shiftIndex);
+
+  StaffSnapshot CollectStaff(size_t & skipped);
+};
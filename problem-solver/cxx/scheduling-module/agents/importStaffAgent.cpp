@@ -1,191 +1,633 @@
 #include "importStaffAgent.hpp"
 #include "keynodes/scheduling-keynodes.hpp"
-#include "utils/stringFormatter.hpp"
-#include <algorithm>
+#include "utils/scheduleCodes.hpp"
+#include "utils/parallelShards.hpp"
 #include <sc-memory/sc_memory.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 
 ScAddr ImportStaffAgent::GetActionClass() const
 {
   return SchedulingKeynodes::action_import_staff_from_csv;
 }
 
-std::map<std::string, ScAddr> ImportStaffAgent::GetProfessionMap()
+ScAddr ImportStaffAgent::GetShiftConcept(std::string_view code) const
 {
-  return {
-      {"повар", SchedulingKeynodes::concept_cook},
-      {"официант", SchedulingKeynodes::concept_waiter},
-      {"уборщик", SchedulingKeynodes::concept_cleaner},
-      {"администратор", SchedulingKeynodes::concept_admin}
-  };
+  ScAddr const * shift = m_shiftMap.Find(code);
+  return shift != nullptr ? *shift : ScAddr();
 }
 
-std::map<std::string, ScAddr> ImportStaffAgent::GetShiftMap()
+std::vector<ScAddr> ImportStaffAgent::GetShiftConcepts(std::string_view shiftCodes) const
 {
-  return {
-      {"M", SchedulingKeynodes::concept_morning_shift},
-      {"D", SchedulingKeynodes::concept_day_shift},
-      {"N", SchedulingKeynodes::concept_night_shift}
-  };
+  std::vector<ScAddr> shifts;
+  StaffCsvReader::ForEachShiftCode(shiftCodes, [&](std::string_view shiftCode) {
+    ScAddr shift = GetShiftConcept(shiftCode);
+    if (shift.IsValid())
+      shifts.push_back(shift);
+  });
+  return shifts;
 }
 
-ScAddr ImportStaffAgent::GetShiftConcept(const std::string& code)
+// ===== Разбор =====
+
+size_t ImportStaffAgent::GetParseWorkers(size_t dataSize) const
+{
+  size_t const workers = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  return std::max<size_t>(std::min(workers, dataSize / MIN_CHUNK_SIZE), 1);
+}
+
+ImportOperation ImportStaffAgent::ParseOperation(std::string_view operation)
 {
-  auto shiftMap = GetShiftMap();
-  auto it = shiftMap.find(code);
-  if (it != shiftMap.end())
-    return it->second;
-  return ScAddr();
+  if (operation.empty())
+    return ImportOperation::Default;
+  if (operation == "add")
+    return ImportOperation::Add;
+  if (operation == "update")
+    return ImportOperation::Update;
+  if (operation == "remove")
+    return ImportOperation::Remove;
+  return ImportOperation::Unknown;
 }
 
+// Читает только кодовые таблицы, поэтому части разбираются одновременно
+ImportedEmployee ImportStaffAgent::ToImportedEmployee(StaffCsvRecord const & record) const
+{
+  ImportedEmployee employee;
+  employee.operation = ParseOperation(record.op);
+  employee.operationCode = record.op;
+  employee.id = record.id;
+  employee.name = record.name;
+  employee.professionCode = record.profession;
+  ScAddr const * profession = m_professionMap.Find(record.profession);
+  if (profession != nullptr)
+  {
+    employee.profession = *profession;
+    employee.allowedShifts = GetShiftConcepts(record.allowedShifts);
+    employee.forbiddenShifts = GetShiftConcepts(record.forbiddenShifts);
+  }
+  return employee;
+}
+
+std::vector<ImportedEmployee> ImportStaffAgent::ParseChunk(
+    std::string_view chunk, char delimiter, CsvFormat const & format) const
+{
+  std::vector<ImportedEmployee> employees;
+  StaffCsvReader reader(chunk, delimiter);
+  CsvFields fields;
+  StaffCsvRecord record;
+
+  while (reader.NextRecord(fields))
+  {
+    StaffCsvReader::ParseRow(fields, format, record);
+    employees.push_back(ToImportedEmployee(record));
+  }
+  return employees;
+}
+
+// ===== Запись в SC-memory =====
+
 void ImportStaffAgent::AddShiftRestriction(
     ScAddr const & employee, ScAddr const & shift, ScAddr const & relation)
 {
-  ScAddr arc = m_context.GenerateConnector(ScType::ConstCommonArc, employee, shift);
-  m_context.GenerateConnector(ScType::ConstPermPosArc, relation, arc);
+  ScAddr arc = m_transaction.GenerateConnector(ScType::ConstCommonArc, employee, shift);
+  m_transaction.GenerateConnector(ScType::ConstPermPosArc, relation, arc);
 }
 
-void ImportStaffAgent::CreateEmployee(
-    const std::string& name,
-    ScAddr const & profession,
-    const std::vector<std::string>& allowedShifts,
-    const std::vector<std::string>& forbiddenShifts)
+void ImportStaffAgent::AddShiftRestrictions(
+    ScAddr const & employee, std::vector<ScAddr> const & shifts, ScAddr const & relation)
 {
-  ScAddr emp = m_context.GenerateNode(ScType::ConstNode);
+  for (ScAddr const & shift : shifts)
+    AddShiftRestriction(employee, shift, relation);
+}
+
+ScAddr ImportStaffAgent::CreateEmployee(ImportedEmployee const & employee)
+{
+  ScAddr emp = m_transaction.GenerateNode(ScType::ConstNode);
 
   // Имя сотрудника
-  ScAddr nameLink = m_context.GenerateLink(ScType::ConstNodeLink);
-  m_context.SetLinkContent(nameLink, name);
-  ScAddr nameArc = m_context.GenerateConnector(ScType::ConstCommonArc, emp, nameLink);
-  m_context.GenerateConnector(ScType::ConstPermPosArc, ScKeynodes::nrel_main_idtf, nameArc);
+  // Содержимое новых ссылок не журналируется: при откате они удаляются целиком
+  ScAddr nameLink = m_transaction.GenerateLink(ScType::ConstNodeLink);
+  m_context.SetLinkContent(nameLink, employee.name);
+  ScAddr nameArc = m_transaction.GenerateConnector(ScType::ConstCommonArc, emp, nameLink);
+  m_transaction.GenerateConnector(ScType::ConstPermPosArc, ScKeynodes::nrel_main_idtf, nameArc);
+
+  // Идентификатор сотрудника из колонки id
+  if (!employee.id.empty())
+    AddEmployeeId(emp, employee.id);
 
   // Профессия и класс
-  m_context.GenerateConnector(ScType::ConstPermPosArc, profession, emp);
-  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_employee, emp);
+  m_transaction.GenerateConnector(ScType::ConstPermPosArc, employee.profession, emp);
+  m_transaction.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_employee, emp);
 
-  // Разрешённые смены
-  for (const auto& shiftCode : allowedShifts)
+  // Разрешённые и запрещённые смены
+  AddShiftRestrictions(emp, employee.allowedShifts, SchedulingKeynodes::nrel_allowed_shift);
+  AddShiftRestrictions(emp, employee.forbiddenShifts, SchedulingKeynodes::nrel_can_not_work);
+  return emp;
+}
+
+void ImportStaffAgent::AddEmployeeId(ScAddr const & employee, std::string const & id)
+{
+  ScAddr idLink = m_transaction.GenerateLink(ScType::ConstNodeLink);
+  m_context.SetLinkContent(idLink, id);
+  ScAddr idArc = m_transaction.GenerateConnector(ScType::ConstCommonArc, employee, idLink);
+  m_transaction.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_employee_id, idArc);
+}
+
+// Без индекса все строки создают новых сотрудников; с индексом найденные сотрудники обновляются
+void ImportStaffAgent::CommitEmployees(
+    std::vector<ImportedEmployee> const & employees, EmployeeIndex * index, ImportStats & stats)
+{
+  for (auto const & employee : employees)
   {
-    if (shiftCode.empty())
+    if (employee.operation != ImportOperation::Default)
+    {
+      CommitOperation(employee, *index, stats);
       continue;
-    ScAddr shift = GetShiftConcept(shiftCode);
-    if (shift.IsValid())
-      AddShiftRestriction(emp, shift, SchedulingKeynodes::nrel_allowed_shift);
+    }
+
+    if (!employee.profession.IsValid())
+    {
+      m_logger.Warning("Unknown profession: ", employee.professionCode);
+      stats.skipped++;
+      continue;
+    }
+
+    ScAddr existing = index != nullptr ? FindEmployee(*index, employee) : ScAddr::Empty;
+    if (existing.IsValid())
+    {
+      UpdateEmployee(existing, employee);
+      stats.updated++;
+    }
+    else
+    {
+      existing = index != nullptr ? RestoreEmployee(*index, employee) : ScAddr::Empty;
+      if (!existing.IsValid())
+        existing = CreateEmployee(employee);
+      stats.created++;
+    }
+
+    // Повторная строка того же сотрудника в файле обновляет уже записанного
+    if (index != nullptr)
+      AddToIndex(*index, existing, employee);
   }
+}
 
-  // Запрещённые смены
-  for (const auto& shiftCode : forbiddenShifts)
+// Строка с колонкой op: add создаёт или обновляет, update только обновляет, remove исключает из штата
+void ImportStaffAgent::CommitOperation(ImportedEmployee const & employee, EmployeeIndex & index, ImportStats & stats)
+{
+  if (employee.operation == ImportOperation::Unknown)
   {
-    if (shiftCode.empty())
-      continue;
-    ScAddr shift = GetShiftConcept(shiftCode);
-    if (shift.IsValid())
-      AddShiftRestriction(emp, shift, SchedulingKeynodes::nrel_can_not_work);
+    m_logger.Warning("Unknown operation \"", employee.operationCode, "\" for employee ", employee.name);
+    stats.skipped++;
+    return;
+  }
+
+  ScAddr const existing = FindEmployee(index, employee);
+  if (employee.operation == ImportOperation::Remove)
+  {
+    if (!existing.IsValid())
+    {
+      m_logger.Warning("Employee to remove not found: ", employee.id.empty() ? employee.name : employee.id);
+      stats.skipped++;
+      return;
+    }
+    RemoveEmployee(existing);
+    RemoveFromIndex(index, existing);
+    stats.removed++;
+    return;
+  }
+
+  if (!employee.profession.IsValid())
+  {
+    m_logger.Warning("Unknown profession: ", employee.professionCode);
+    stats.skipped++;
+    return;
+  }
+
+  if (existing.IsValid())
+  {
+    UpdateEmployee(existing, employee);
+    AddToIndex(index, existing, employee);
+    stats.updated++;
+  }
+  else if (employee.operation == ImportOperation::Add)
+  {
+    ScAddr added = RestoreEmployee(index, employee);
+    if (!added.IsValid())
+      added = CreateEmployee(employee);
+    AddToIndex(index, added, employee);
+    stats.created++;
+  }
+  else
+  {
+    m_logger.Warning("Employee to update not found: ", employee.id.empty() ? employee.name : employee.id);
+    stats.skipped++;
   }
 }
 
-std::string ImportStaffAgent::GetCsvData(ScAction & action)
+// ===== Обновление существующих сотрудников =====
+
+std::string ImportStaffAgent::GetAttributeContent(ScAddr const & element, ScAddr const & relation)
 {
+  std::string content;
   ScIterator5Ptr it5 = m_context.CreateIterator5(
-      action, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
-      SchedulingKeynodes::nrel_file_content);
-  if (!it5->Next())
+      element, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc, relation);
+  if (it5->Next())
+    m_context.GetLinkContent(it5->Get(2), content);
+  return content;
+}
+
+EmployeeIndex ImportStaffAgent::BuildEmployeeIndex()
+{
+  EmployeeIndex index;
+  ScIterator3Ptr it = m_context.CreateIterator3(
+      SchedulingKeynodes::concept_employee, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it->Next())
+  {
+    ScAddr employee = it->Get(2);
+    std::string const id = GetAttributeContent(employee, SchedulingKeynodes::nrel_employee_id);
+    if (!id.empty())
+    {
+      index.byId.emplace(id, employee);
+      index.withId.insert(employee);
+    }
+    index.byName.emplace(GetAttributeContent(employee, ScKeynodes::nrel_main_idtf), employee);
+  }
+
+  // Исключённые сотрудники не входят в concept_employee, но хранят идентификатор
+  ScIterator5Ptr itId = m_context.CreateIterator5(
+      ScType::ConstNode, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_employee_id);
+  while (itId->Next())
+  {
+    ScAddr employee = itId->Get(0);
+    if (index.withId.count(employee) > 0)
+      continue;
+
+    std::string id;
+    m_context.GetLinkContent(itId->Get(2), id);
+    if (!id.empty() && index.byId.count(id) == 0)
+      index.removedById.emplace(id, employee);
+  }
+
+  m_logger.Info(
+      "Employee index built: ", index.byId.size(), " by id, ", index.byName.size(), " by name, ",
+      index.removedById.size(), " removed");
+  return index;
+}
+
+ScAddr ImportStaffAgent::FindEmployee(EmployeeIndex const & index, ImportedEmployee const & employee) const
+{
+  if (!employee.id.empty())
   {
-    m_logger.Error("CSV data not provided");
-    return "";
+    auto const it = index.byId.find(employee.id);
+    if (it != index.byId.cend())
+      return it->second;
   }
 
-  std::string csvData;
-  m_context.GetLinkContent(it5->Get(2), csvData);
-  return csvData;
+  // Строка с идентификатором не должна занять сотрудника, у которого уже есть другой идентификатор
+  auto const it = index.byName.find(employee.name);
+  if (it == index.byName.cend() || (!employee.id.empty() && index.withId.count(it->second) > 0))
+    return ScAddr::Empty;
+  return it->second;
 }
 
-CsvFormat ImportStaffAgent::ParseCsvHeader(const std::string& header)
+void ImportStaffAgent::AddToIndex(EmployeeIndex & index, ScAddr const & addr, ImportedEmployee const & employee)
 {
-  CsvFormat format;
-  format.hasForbiddenColumn = (header.find("запрещённые") != std::string::npos || 
-                                header.find("forbidden") != std::string::npos);
-  format.hasAllowedColumn = (header.find("разрешённые") != std::string::npos || 
-                             header.find("allowed") != std::string::npos);
-  format.columnCount = 1 + std::count(header.begin(), header.end(), ',');
-  return format;
+  if (!employee.id.empty())
+  {
+    index.byId[employee.id] = addr;
+    index.withId.insert(addr);
+  }
+  index.byName[employee.name] = addr;
 }
 
-void ImportStaffAgent::ParseCsvRow(
-    const std::string& line,
-    CsvFormat const & format,
-    std::string& profession,
-    std::string& name,
-    std::vector<std::string>& allowedShifts,
-    std::vector<std::string>& forbiddenShifts)
+// Исключённый сотрудник остаётся доступен по идентификатору для возвращения в штат
+void ImportStaffAgent::RemoveFromIndex(EmployeeIndex & index, ScAddr const & addr)
 {
-  std::stringstream ss(line);
-  std::string col3, col4;
+  auto const erase = [&addr](std::unordered_map<std::string, ScAddr> & keys, std::string const & key) {
+    auto const it = keys.find(key);
+    if (it != keys.cend() && it->second == addr)
+      keys.erase(it);
+  };
+  std::string const id = GetAttributeContent(addr, SchedulingKeynodes::nrel_employee_id);
+  erase(index.byId, id);
+  erase(index.byName, GetAttributeContent(addr, ScKeynodes::nrel_main_idtf));
+  index.withId.erase(addr);
+  if (!id.empty())
+    index.removedById[id] = addr;
+}
+
+// Сотрудник, исключённый раньше, возвращается в штат на прежнем узле, чтобы у одного идентификатора
+// не появилось двух узлов; имя, профессия и ограничения берутся из строки
+ScAddr ImportStaffAgent::RestoreEmployee(EmployeeIndex & index, ImportedEmployee const & employee)
+{
+  if (employee.id.empty())
+    return ScAddr::Empty;
+
+  auto const it = index.removedById.find(employee.id);
+  if (it == index.removedById.cend())
+    return ScAddr::Empty;
 
-  std::getline(ss, profession, ',');
-  std::getline(ss, name, ',');
-  std::getline(ss, col3, ',');
-  if (format.columnCount >= 4)
-    std::getline(ss, col4, ',');
+  ScAddr const addr = it->second;
+  index.removedById.erase(it);
+  UpdateEmployee(addr, employee);
+  m_transaction.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_employee, addr);
+  return addr;
+}
 
-  profession = StringFormatter::Trim(profession);
-  name = StringFormatter::Trim(name);
-  col3 = StringFormatter::Trim(col3);
-  col4 = StringFormatter::Trim(col4);
+void ImportStaffAgent::UpdateEmployee(ScAddr const & addr, ImportedEmployee const & employee)
+{
+  // Сотрудник, найденный по имени, получает идентификатор из строки
+  if (!employee.id.empty() && GetAttributeContent(addr, SchedulingKeynodes::nrel_employee_id).empty())
+    AddEmployeeId(addr, employee.id);
 
-  if (format.columnCount >= 4)
+  // По идентификатору может прийти новое имя
+  ScIterator5Ptr nameIt = m_context.CreateIterator5(
+      addr, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc, ScKeynodes::nrel_main_idtf);
+  if (nameIt->Next())
   {
-    allowedShifts = StringFormatter::ParseShifts(col3);
-    forbiddenShifts = StringFormatter::ParseShifts(col4);
+    std::string name;
+    m_context.GetLinkContent(nameIt->Get(2), name);
+    if (name != employee.name)
+      m_transaction.SetLinkContent(nameIt->Get(2), employee.name);
   }
-  else if (format.columnCount == 3)
+
+  SetProfession(addr, employee.profession);
+  SetShiftRestrictions(addr, employee.allowedShifts, SchedulingKeynodes::nrel_allowed_shift);
+  SetShiftRestrictions(addr, employee.forbiddenShifts, SchedulingKeynodes::nrel_can_not_work);
+}
+
+void ImportStaffAgent::SetProfession(ScAddr const & employee, ScAddr const & profession)
+{
+  for (ScAddr const & otherProfession : m_professionMap.GetClasses())
   {
-    if (format.hasForbiddenColumn && !format.hasAllowedColumn)
-      forbiddenShifts = StringFormatter::ParseShifts(col3);
+    if (otherProfession == profession)
+      continue;
+
+    std::vector<ScAddr> staleArcs;
+    ScIterator3Ptr it = m_context.CreateIterator3(otherProfession, ScType::ConstPermPosArc, employee);
+    while (it->Next())
+      staleArcs.push_back(it->Get(1));
+    for (ScAddr const & arc : staleArcs)
+      m_transaction.EraseConnector(arc);
+  }
+
+  if (!m_context.CheckConnector(profession, employee, ScType::ConstPermPosArc))
+    m_transaction.GenerateConnector(ScType::ConstPermPosArc, profession, employee);
+}
+
+// Узел сотрудника с именем и идентификатором остаётся, чтобы не ломать ссылки из прошлых расписаний;
+// удаляются ограничения смен и принадлежность классу сотрудников и профессии
+void ImportStaffAgent::RemoveEmployee(ScAddr const & addr)
+{
+  EraseRelationArcs(addr, SchedulingKeynodes::nrel_allowed_shift);
+  EraseRelationArcs(addr, SchedulingKeynodes::nrel_can_not_work);
+
+  std::vector<ScAddr> classArcs;
+  auto const collectClassArcs = [&](ScAddr const & classAddr) {
+    ScIterator3Ptr it = m_context.CreateIterator3(classAddr, ScType::ConstPermPosArc, addr);
+    while (it->Next())
+      classArcs.push_back(it->Get(1));
+  };
+  collectClassArcs(SchedulingKeynodes::concept_employee);
+  for (ScAddr const & profession : m_professionMap.GetClasses())
+    collectClassArcs(profession);
+
+  for (ScAddr const & arc : classArcs)
+    m_transaction.EraseConnector(arc);
+}
+
+void ImportStaffAgent::EraseRelationArcs(ScAddr const & employee, ScAddr const & relation)
+{
+  std::vector<ScAddr> arcs;
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      employee, ScType::ConstCommonArc, ScType::ConstNode, ScType::ConstPermPosArc, relation);
+  while (it->Next())
+    arcs.push_back(it->Get(1));
+  for (ScAddr const & arc : arcs)
+    m_transaction.EraseConnector(arc);
+}
+
+// Меняет только отличающиеся ограничения: лишние дуги удаляются, недостающие создаются
+void ImportStaffAgent::SetShiftRestrictions(
+    ScAddr const & employee, std::vector<ScAddr> const & shifts, ScAddr const & relation)
+{
+  ScAddrUnorderedSet required(shifts.cbegin(), shifts.cend());
+  ScAddrUnorderedSet existing;
+  std::vector<ScAddr> staleArcs;
+
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      employee, ScType::ConstCommonArc, ScType::ConstNode, ScType::ConstPermPosArc, relation);
+  while (it->Next())
+  {
+    if (required.count(it->Get(2)) > 0)
+      existing.insert(it->Get(2));
     else
-      allowedShifts = StringFormatter::ParseShifts(col3);
+      staleArcs.push_back(it->Get(1));
+  }
+
+  for (ScAddr const & arc : staleArcs)
+    m_transaction.EraseConnector(arc);
+
+  for (ScAddr const & shift : shifts)
+  {
+    if (existing.insert(shift).second)
+      AddShiftRestriction(employee, shift, relation);
   }
 }
 
-ScResult ImportStaffAgent::DoProgram(ScAction & action)
+bool ImportStaffAgent::GetActionLinkContent(
+    ScAction & action, ScAddr const & relation, std::string & content)
 {
-  std::string csvData = GetCsvData(action);
-  if (csvData.empty())
+  ScIterator5Ptr it5 = m_context.CreateIterator5(
+      action, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc, relation);
+  if (!it5->Next())
+    return false;
+
+  m_context.GetLinkContent(it5->Get(2), content);
+  return true;
+}
+
+// Файл по пути nrel_file_path отображается в память, иначе данные берутся из ссылки nrel_file_content.
+// Возвращаемые данные действительны, пока существуют file и linkContent. Пустой файл — это ноль строк,
+// а не ошибка: об ошибке говорит только статус отображения
+bool ImportStaffAgent::GetInputData(
+    ScAction & action, MappedFile & file, std::string & linkContent, std::string_view & data)
+{
+  std::string filePath;
+  if (GetActionLinkContent(action, SchedulingKeynodes::nrel_file_path, filePath))
   {
-    m_logger.Error("CSV data is empty");
-    return action.FinishWithError();
+    if (!file.Open(filePath))
+    {
+      m_logger.Error(file.GetError());
+      return false;
+    }
+    data = file.GetContent();
+    m_logger.Info("Staff file mapped: ", filePath, ", ", data.size(), " bytes");
+    if (data.empty())
+      m_logger.Warning("Staff file ", filePath, " is empty: no header and no rows to import");
+    return true;
   }
 
-  std::istringstream dataStream(csvData);
-  std::string line;
+  if (!GetActionLinkContent(action, SchedulingKeynodes::nrel_file_content, linkContent))
+  {
+    m_logger.Error("Staff data not provided");
+    return false;
+  }
+  if (linkContent.empty())
+  {
+    m_logger.Error("Staff data is empty");
+    return false;
+  }
+  data = linkContent;
+  return true;
+}
 
-  // Парсим заголовок
-  std::getline(dataStream, line);
-  CsvFormat format = ParseCsvHeader(StringFormatter::Trim(line));
+// Разделитель задаётся одним символом в ссылке nrel_csv_delimiter, по умолчанию ','
+char ImportStaffAgent::GetCsvDelimiter(ScAction & action)
+{
+  std::string delimiter;
+  if (!GetActionLinkContent(action, SchedulingKeynodes::nrel_csv_delimiter, delimiter))
+    return StaffCsvReader::DEFAULT_DELIMITER;
 
-  auto profMap = GetProfessionMap();
-  int importedCount = 0;
+  if (delimiter.size() != 1 || delimiter[0] == '"' || delimiter[0] == '\n' || delimiter[0] == '\r')
+  {
+    m_logger.Warning("Invalid CSV delimiter \"", delimiter, "\", using ','");
+    return StaffCsvReader::DEFAULT_DELIMITER;
+  }
+  return delimiter[0];
+}
 
-  while (std::getline(dataStream, line))
+CsvFormat ImportStaffAgent::ParseCsvHeader(CsvFields const & columns)
+{
+  CsvFormat format;
+  for (size_t i = 0; i < columns.size(); ++i)
   {
-    line = StringFormatter::Trim(line);
-    if (line.empty())
+    std::string_view const column = columns[i];
+    if (column == "id" || column == "employee_id")
+    {
+      format.idColumn = static_cast<int>(i);
       continue;
+    }
+    if (column == "op" || column == "operation")
+    {
+      format.opColumn = static_cast<int>(i);
+      continue;
+    }
+    if (column.find("запрещённые") != std::string_view::npos || column.find("forbidden") != std::string_view::npos)
+      format.hasForbiddenColumn = true;
+    if (column.find("разрешённые") != std::string_view::npos || column.find("allowed") != std::string_view::npos)
+      format.hasAllowedColumn = true;
+  }
+  format.columnCount = columns.size() - (format.idColumn >= 0 ? 1 : 0) - (format.opColumn >= 0 ? 1 : 0);
+  return format;
+}
+
+// CSV: заголовок определяет формат, тело делится на части по концам записей и разбирается параллельно
+bool ImportStaffAgent::ParseEmployees(
+    ScAction & action, std::string_view data, std::vector<std::vector<ImportedEmployee>> & parsedChunks, ImportStats &)
+{
+  char const delimiter = GetCsvDelimiter(action);
+  StaffCsvReader headerReader(data, delimiter);
+  CsvFields fields;
+
+  // Парсим заголовок
+  headerReader.NextRecord(fields);
+  CsvFormat const format = ParseCsvHeader(fields);
 
-    std::string profession, name;
-    std::vector<std::string> allowedShifts, forbiddenShifts;
+  std::string_view const body = data.substr(headerReader.GetPosition());
+  auto const chunks = StaffCsvReader::SplitChunks(body, GetParseWorkers(body.size()), delimiter);
 
-    ParseCsvRow(line, format, profession, name, allowedShifts, forbiddenShifts);
+  parsedChunks.resize(chunks.size());
+  RunShards(chunks.size(), [&](size_t chunk) {
+    parsedChunks[chunk] = ParseChunk(chunks[chunk], delimiter, format);
+  });
+  return true;
+}
+
+ScResult ImportStaffAgent::RollbackImport(ScAction & action)
+{
+  m_logger.Info("Import rolled back: ", m_transaction.Rollback(), " changes undone");
+  return action.FinishWithError();
+}
+
+ScResult ImportStaffAgent::DoProgram(ScAction & action)
+{
+  MappedFile file;
+  std::string linkContent;
+  std::string_view data;
+  if (!GetInputData(action, file, linkContent, data))
+    return action.FinishWithError();
+
+  // Кодовые таблицы загружаются из базы знаний один раз на импорт, строки только ищут в них
+  m_professionMap = ScheduleCodes::LoadProfessionMap(m_context);
+  m_shiftMap = ScheduleCodes::LoadShiftMap(m_context);
+
+  // Записи разбираются по частям параллельно, затем записываются в SC-memory в исходном порядке строк
+  ImportStats stats;
+  std::vector<std::vector<ImportedEmployee>> parsedChunks;
+  auto const parseStarted = std::chrono::steady_clock::now();
+  if (!ParseEmployees(action, data, parsedChunks, stats))
+    return action.FinishWithError();
+  m_logger.Info(
+      "Staff data parsed in ", parsedChunks.size(), " chunks: ",
+      std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - parseStarted).count(),
+      " ms");
 
-    if (profMap.count(profession) == 0)
+  // В режиме обновления и при наличии операций в записях существующие сотрудники изменяются на месте
+  bool const useIndex =
+      m_context.CheckConnector(action, SchedulingKeynodes::import_staff_upsert, ScType::ConstPermPosArc)
+      || std::any_of(parsedChunks.cbegin(), parsedChunks.cend(), [](auto const & employees) {
+           return std::any_of(employees.cbegin(), employees.cend(), [](ImportedEmployee const & employee) {
+             return employee.operation != ImportOperation::Default;
+           });
+         });
+  EmployeeIndex index;
+  if (useIndex)
+    index = BuildEmployeeIndex();
+
+  // Все изменения журналируются; при любой ошибке записи (или пропущенной строке в режиме import_staff_atomic)
+  // импорт откатывается целиком. Страж откатывает журнал, если до Commit дело не дошло
+  bool const isAtomic =
+      m_context.CheckConnector(action, SchedulingKeynodes::import_staff_atomic, ScType::ConstPermPosArc);
+  ImportTransaction::Guard const transactionGuard(m_transaction);
+  try
+  {
+    for (auto & employees : parsedChunks)
     {
-      m_logger.Warning("Unknown profession: ", profession);
-      continue;
+      CommitEmployees(employees, useIndex ? &index : nullptr, stats);
+      std::vector<ImportedEmployee>().swap(employees);
+      if (isAtomic && stats.skipped > 0)
+        break;
     }
+  }
+  catch (utils::ScException const & exception)
+  {
+    m_logger.Error("Staff import failed: ", exception.Message());
+    return RollbackImport(action);
+  }
+  catch (std::exception const & exception)
+  {
+    m_logger.Error("Staff import failed: ", exception.what());
+    return RollbackImport(action);
+  }
+  catch (...)
+  {
+    m_logger.Error("Staff import failed with unknown exception");
+    return RollbackImport(action);
+  }
 
-    CreateEmployee(name, profMap[profession], allowedShifts, forbiddenShifts);
-    importedCount++;
+  if (isAtomic && stats.skipped > 0)
+  {
+    m_logger.Error("Staff import rejected: ", stats.skipped, " invalid rows");
+    return RollbackImport(action);
   }
+  m_transaction.Commit();
 
-  m_logger.Info("Staff imported successfully: ", importedCount, " employees");
+  m_logger.Info(
+      "Staff imported successfully: ", stats.created, " created, ", stats.updated, " updated, ", stats.removed,
+      " removed, ", stats.skipped, " skipped");
   return action.FinishSuccessfully();
 }
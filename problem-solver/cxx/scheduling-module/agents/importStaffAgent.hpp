@@ -1,14 +1,56 @@
 #pragma once
 #include <sc-memory/sc_agent.hpp>
-#include <map>
-#include <vector>
+#include "utils/importTransaction.hpp"
+#include "utils/mappedFile.hpp"
+#include "utils/scheduleCodes.hpp"
+#include "utils/staffCsvReader.hpp"
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
-struct CsvFormat
+// Операция из колонки op; без колонки строка создаёт сотрудника (или обновляет в режиме обновления)
+enum class ImportOperation
 {
-  bool hasForbiddenColumn = false;
-  bool hasAllowedColumn = false;
-  int columnCount = 0;
+  Default,
+  Add,
+  Update,
+  Remove,
+  Unknown
+};
+
+// Разобранная строка CSV-файла штата, готовая к записи в SC-memory
+struct ImportedEmployee
+{
+  ImportOperation operation = ImportOperation::Default;
+  std::string operationCode;  // Исходное значение op для предупреждений
+  std::string id;  // Пусто, если в файле нет колонки id
+  std::string professionCode;
+  ScAddr profession;  // Пустой адрес, если профессия неизвестна
+  std::string name;
+  std::vector<ScAddr> allowedShifts;
+  std::vector<ScAddr> forbiddenShifts;
+};
+
+// Индекс существующих сотрудников для обновления при повторном импорте.
+// Строится один раз за импорт; сотрудник с идентификатором ищется по нему, без идентификатора — по имени.
+// Если идентификатор не найден, строка сопоставляется по имени с сотрудником, у которого идентификатора нет
+// (импортированным до появления колонки id). Исключённые из штата сотрудники сохраняют узел и идентификатор
+// и возвращаются в штат строкой с тем же идентификатором
+struct EmployeeIndex
+{
+  std::unordered_map<std::string, ScAddr> byId;
+  std::unordered_map<std::string, ScAddr> byName;
+  ScAddrUnorderedSet withId;
+  std::unordered_map<std::string, ScAddr> removedById;
+};
+
+struct ImportStats
+{
+  int created = 0;
+  int updated = 0;
+  int removed = 0;
+  int skipped = 0;
 };
 
 class ImportStaffAgent : public ScActionInitiatedAgent
@@ -17,29 +59,79 @@ public:
   ScAddr GetActionClass() const override;
   ScResult DoProgram(ScAction & action) override;
 
+protected:
+  // ===== Разбор (без обращения к SC-memory, выполняется параллельно) =====
+
+  // Разбирает данные в записи по частям в исходном порядке строк; некорректные записи учитываются
+  // в stats.skipped. false завершает импорт с ошибкой
+  virtual bool ParseEmployees(
+      ScAction & action,
+      std::string_view data,
+      std::vector<std::vector<ImportedEmployee>> & parsedChunks,
+      ImportStats & stats);
+
+  size_t GetParseWorkers(size_t dataSize) const;
+  ImportedEmployee ToImportedEmployee(StaffCsvRecord const & record) const;
+
+  // Кодовые таблицы загружаются до разбора и определяют допустимые классы профессий и смен
+  ScheduleCodes::CodeMap m_professionMap;
+  ScheduleCodes::CodeMap m_shiftMap;
+
 private:
-  std::map<std::string, ScAddr> GetProfessionMap();
-  std::map<std::string, ScAddr> GetShiftMap();
-  ScAddr GetShiftConcept(const std::string& shiftCode);
+  // Меньшие данные разбираются в одном потоке
+  static constexpr size_t MIN_CHUNK_SIZE = 1 << 20;
+
+  ImportTransaction m_transaction{m_context};
+
+  ScAddr GetShiftConcept(std::string_view shiftCode) const;
+  std::vector<ScAddr> GetShiftConcepts(std::string_view shiftCodes) const;
+
+  static ImportOperation ParseOperation(std::string_view operation);
+  std::vector<ImportedEmployee> ParseChunk(
+      std::string_view chunk,
+      char delimiter,
+      CsvFormat const & format) const;
+  
+  // ===== Запись в SC-memory =====
+  
+  void CommitEmployees(
+      std::vector<ImportedEmployee> const & employees,
+      EmployeeIndex * index,
+      ImportStats & stats);
+  ScAddr CreateEmployee(ImportedEmployee const & employee);
+  void AddEmployeeId(ScAddr const & employee, std::string const & id);
+  ScAddr RestoreEmployee(EmployeeIndex & index, ImportedEmployee const & employee);
+  ScResult RollbackImport(ScAction & action);
+  void CommitOperation(ImportedEmployee const & employee, EmployeeIndex & index, ImportStats & stats);
   
-  void CreateEmployee(
-      const std::string& name,
-      ScAddr const & profession,
-      const std::vector<std::string>& allowedShifts,
-      const std::vector<std::string>& forbiddenShifts);
+  // ===== Обновление существующих сотрудников =====
+  
+  std::string GetAttributeContent(ScAddr const & element, ScAddr const & relation);
+  EmployeeIndex BuildEmployeeIndex();
+  ScAddr FindEmployee(EmployeeIndex const & index, ImportedEmployee const & employee) const;
+  void AddToIndex(EmployeeIndex & index, ScAddr const & addr, ImportedEmployee const & employee);
+  void RemoveFromIndex(EmployeeIndex & index, ScAddr const & addr);
+  void UpdateEmployee(ScAddr const & addr, ImportedEmployee const & employee);
+  void RemoveEmployee(ScAddr const & addr);
+  void EraseRelationArcs(ScAddr const & employee, ScAddr const & relation);
+  void SetProfession(ScAddr const & employee, ScAddr const & profession);
+  void SetShiftRestrictions(
+      ScAddr const & employee,
+      std::vector<ScAddr> const & shifts,
+      ScAddr const & relation);
+  
+  void AddShiftRestrictions(
+      ScAddr const & employee,
+      std::vector<ScAddr> const & shifts,
+      ScAddr const & relation);
   
   void AddShiftRestriction(
       ScAddr const & employee,
       ScAddr const & shift,
       ScAddr const & relation);
   
-  std::string GetCsvData(ScAction & action);
-  CsvFormat ParseCsvHeader(const std::string& header);
-  void ParseCsvRow(
-      const std::string& line,
-      CsvFormat const & format,
-      std::string& profession,
-      std::string& name,
-      std::vector<std::string>& allowedShifts,
-      std::vector<std::string>& forbiddenShifts);
+  bool GetActionLinkContent(ScAction & action, ScAddr const & relation, std::string & content);
+  bool GetInputData(ScAction & action, MappedFile & file, std::string & linkContent, std::string_view & data);
+  char GetCsvDelimiter(ScAction & action);
+  CsvFormat ParseCsvHeader(CsvFields const & columns);
 };
@@ -0,0 +1,62 @@
+#include "importStaffFromJsonlAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/parallelShards.hpp"
+#include "utils/staffJsonlReader.hpp"
+
+#include <algorithm>
+
+ScAddr ImportStaffFromJsonlAgent::GetActionClass() const
+{
+  return SchedulingKeynodes::action_import_staff_from_jsonl;
+}
+
+std::vector<ImportedEmployee> ImportStaffFromJsonlAgent::ParseChunk(
+    std::string_view chunk, size_t & invalidCount, size_t & firstInvalidLine) const
+{
+  std::vector<ImportedEmployee> employees;
+  StaffJsonlReader reader(chunk);
+  StaffCsvRecord record;
+
+  while (reader.NextRecord(record))
+    employees.push_back(ToImportedEmployee(record));
+
+  invalidCount = reader.GetInvalidCount();
+  firstInvalidLine = reader.GetFirstInvalidLine();
+  return employees;
+}
+
+// Строки JSON Lines независимы, поэтому данные делятся на части по переводам строк без заголовка
+bool ImportStaffFromJsonlAgent::ParseEmployees(
+    ScAction &, std::string_view data, std::vector<std::vector<ImportedEmployee>> & parsedChunks, ImportStats & stats)
+{
+  auto const chunks = StaffJsonlReader::SplitChunks(data, GetParseWorkers(data.size()));
+
+  parsedChunks.resize(chunks.size());
+  std::vector<size_t> invalidCounts(chunks.size(), 0);
+  std::vector<size_t> firstInvalidLines(chunks.size(), 0);
+  std::vector<size_t> lineCounts(chunks.size(), 0);
+  RunShards(chunks.size(), [&](size_t chunk) {
+    parsedChunks[chunk] = ParseChunk(chunks[chunk], invalidCounts[chunk], firstInvalidLines[chunk]);
+    lineCounts[chunk] = std::count(chunks[chunk].cbegin(), chunks[chunk].cend(), '\n');
+  });
+
+  // Каждая часть заканчивается переводом строки, поэтому номер строки в файле — номер внутри части
+  // плюс число строк в предыдущих частях
+  size_t invalidCount = 0;
+  size_t firstInvalidLine = 0;
+  size_t lineOffset = 0;
+  for (size_t chunk = 0; chunk < chunks.size(); ++chunk)
+  {
+    if (firstInvalidLine == 0 && firstInvalidLines[chunk] > 0)
+      firstInvalidLine = lineOffset + firstInvalidLines[chunk];
+    invalidCount += invalidCounts[chunk];
+    lineOffset += lineCounts[chunk];
+  }
+
+  if (invalidCount > 0)
+  {
+    m_logger.Warning("Invalid JSON lines skipped: ", invalidCount, ", first at line ", firstInvalidLine);
+    stats.skipped += static_cast<int>(invalidCount);
+  }
+  return true;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "importStaffAgent.hpp"
+
+// Импорт штата из JSON Lines. Источник данных, параметры действия и запись в SC-memory
+// (включая обновление, операции и откат) общие с импортом CSV
+class ImportStaffFromJsonlAgent : public ImportStaffAgent
+{
+public:
+  ScAddr GetActionClass() const override;
+
+protected:
+  bool ParseEmployees(
+      ScAction & action,
+      std::string_view data,
+      std::vector<std::vector<ImportedEmployee>> & parsedChunks,
+      ImportStats & stats) override;
+
+private:
+  // firstInvalidLine — номер первой некорректной строки внутри части (с единицы) или 0
+  std::vector<ImportedEmployee> ParseChunk(
+      std::string_view chunk, size_t & invalidCount, size_t & firstInvalidLine) const;
+};
@@ -0,0 +1,77 @@
+#include "importStaffFromSnapshotAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/staffSnapshot.hpp"
+
+ScAddr ImportStaffFromSnapshotAgent::GetActionClass() const
+{
+  return SchedulingKeynodes::action_import_staff_from_snapshot;
+}
+
+// Класс, которого нет в базе знаний или в кодовой таблице, получает пустой адрес: элемент с тем же
+// системным идентификатором, но не являющийся профессией (сменой), не принимается
+std::vector<ScAddr> ImportStaffFromSnapshotAgent::ResolveClasses(
+    std::vector<std::string> const & identifiers, ScheduleCodes::CodeMap const & codes)
+{
+  std::vector<ScAddr> classes(identifiers.size());
+  for (size_t i = 0; i < identifiers.size(); ++i)
+  {
+    if (!m_context.SearchElementBySystemIdentifier(identifiers[i], classes[i]))
+      m_logger.Warning("Unknown class in snapshot: ", identifiers[i]);
+    else if (codes.FindCode(classes[i]).empty())
+    {
+      m_logger.Warning("Class in snapshot is not in the code table: ", identifiers[i]);
+      classes[i] = ScAddr::Empty;
+    }
+  }
+  return classes;
+}
+
+// Сотрудник с неизвестной профессией пропускается при записи. Сотрудник с неизвестной сменой в ограничениях
+// пропускается здесь же: без запрещённой смены его можно было бы поставить на неё
+bool ImportStaffFromSnapshotAgent::ParseEmployees(
+    ScAction &, std::string_view data, std::vector<std::vector<ImportedEmployee>> & parsedChunks, ImportStats & stats)
+{
+  StaffSnapshot snapshot;
+  std::string error;
+  if (!StaffSnapshotCodec::Decode(data, snapshot, error))
+  {
+    m_logger.Error("Invalid staff snapshot: ", error);
+    return false;
+  }
+
+  std::vector<ScAddr> const professions = ResolveClasses(snapshot.professions, m_professionMap);
+  std::vector<ScAddr> const shifts = ResolveClasses(snapshot.shifts, m_shiftMap);
+  auto const resolveShifts = [&shifts](std::vector<uint32_t> const & indices, std::vector<ScAddr> & addrs) {
+    addrs.reserve(indices.size());
+    for (uint32_t const index : indices)
+    {
+      if (!shifts[index].IsValid())
+        return false;
+      addrs.push_back(shifts[index]);
+    }
+    return true;
+  };
+
+  std::vector<ImportedEmployee> employees;
+  employees.reserve(snapshot.employees.size());
+  for (StaffSnapshotEmployee & record : snapshot.employees)
+  {
+    ImportedEmployee employee;
+    if (!resolveShifts(record.allowedShifts, employee.allowedShifts)
+        || !resolveShifts(record.forbiddenShifts, employee.forbiddenShifts))
+    {
+      m_logger.Warning("Employee ", record.name, " skipped: unknown shift class in restrictions");
+      stats.skipped++;
+      continue;
+    }
+
+    employee.id = std::move(record.id);
+    employee.name = std::move(record.name);
+    employee.professionCode = snapshot.professions[record.profession];
+    employee.profession = professions[record.profession];
+    employees.push_back(std::move(employee));
+  }
+
+  parsedChunks.push_back(std::move(employees));
+  return true;
+}
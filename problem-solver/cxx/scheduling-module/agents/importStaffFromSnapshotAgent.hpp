@@ -0,0 +1,23 @@
+#pragma once
+
+#include "importStaffAgent.hpp"
+
+// Загрузка штата из двоичного снимка ExportStaffSnapshotAgent. Записи снимка не требуют разбора
+// и поиска кодов: словари классов разрешаются один раз, запись в SC-memory общая с импортом CSV
+class ImportStaffFromSnapshotAgent : public ImportStaffAgent
+{
+public:
+  ScAddr GetActionClass() const override;
+
+protected:
+  bool ParseEmployees(
+      ScAction & action,
+      std::string_view data,
+      std::vector<std::vector<ImportedEmployee>> & parsedChunks,
+      ImportStats & stats) override;
+
+private:
+  std::vector<ScAddr> ResolveClasses(
+      std::vector<std::string> const & identifiers,
+      ScheduleCodes::CodeMap const & codes);
+};
@@ -0,0 +1,201 @@
+#include "scheduleExportAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/scheduleCodes.hpp"
+
+#include <sc-memory/sc_memory_headers.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+ScAddr ScheduleExportAgent::GetActionClass() const
+{
+  return SchedulingKeynodes::action_export_schedule;
+}
+
+std::string ScheduleExportAgent::GetLinkString(ScAddr const & link)
+{
+  std::string content;
+  if (link.IsValid() && m_context.GetElementType(link).IsLink())
+    m_context.GetLinkContent(link, content);
+  return content;
+}
+
+std::string ScheduleExportAgent::GetEmployeeName(ScAddr const & employee)
+{
+  return GetLinkString(GetAttribute(employee, ScKeynodes::nrel_main_idtf));
+}
+
+std::string ScheduleExportAgent::GetEmployeeProfession(ScAddr const & employee)
+{
+  for (ScAddr const & profession : m_professionCodes.GetClasses())
+  {
+    if (m_context.CheckConnector(profession, employee, ScType::ConstPermPosArc))
+      return std::string(m_professionCodes.FindCode(profession));
+  }
+  return "";
+}
+
+ScAddr ScheduleExportAgent::GetAttribute(ScAddr const & element, ScAddr const & relation)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      element, ScType::ConstCommonArc, ScType::Unknown, ScType::ConstPermPosArc, relation);
+  return it->Next() ? it->Get(2) : ScAddr::Empty;
+}
+
+std::unique_ptr<ScheduleExportWriter> ScheduleExportAgent::CreateWriter(
+    ScAddr const & format,
+    std::ostream & out,
+    ScAddr const & weekStartLink)
+{
+  if (format == SchedulingKeynodes::schedule_export_csv)
+    return std::make_unique<CsvScheduleWriter>(out);
+
+  if (format == SchedulingKeynodes::schedule_export_ics)
+  {
+    int64_t weekStart = IcsScheduleWriter::GetCurrentWeekStart();
+    std::string const date = GetLinkString(weekStartLink);
+    if (!date.empty() && !IcsScheduleWriter::ParseDate(date, weekStart))
+    {
+      m_logger.Warning("ScheduleExportAgent: Invalid week start '", date, "', using current week");
+      weekStart = IcsScheduleWriter::GetCurrentWeekStart();
+    }
+    return std::make_unique<IcsScheduleWriter>(out, weekStart);
+  }
+
+  return nullptr;
+}
+
+// В памяти держатся только адреса назначений, сгруппированные по слотам (день × смена),
+// чтобы строки выгрузки шли в порядке недели
+std::vector<std::vector<ScAddr>> ScheduleExportAgent::GroupAssignmentsBySlot(ScAddr const & schedule)
+{
+  auto const weekdays = ScheduleCodes::GetWeekdays();
+  auto const shiftTypes = ScheduleCodes::GetShiftTypes();
+  std::vector<std::vector<ScAddr>> slots(weekdays.size() * shiftTypes.size());
+
+  ScIterator3Ptr it = m_context.CreateIterator3(schedule, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it->Next())
+  {
+    ScAddr assignment = it->Get(2);
+    if (!m_context.CheckConnector(SchedulingKeynodes::concept_shift_assignment, assignment, ScType::ConstPermPosArc))
+      continue;
+
+    ScAddr const day = GetAttribute(assignment, SchedulingKeynodes::nrel_shift_day);
+    ScAddr const shiftType = GetAttribute(assignment, SchedulingKeynodes::nrel_shift_type);
+    auto const dayIt = std::find(weekdays.cbegin(), weekdays.cend(), day);
+    auto const shiftIt = std::find(shiftTypes.cbegin(), shiftTypes.cend(), shiftType);
+    if (dayIt == weekdays.cend() || shiftIt == shiftTypes.cend())
+      continue;
+
+    size_t const dayIndex = std::distance(weekdays.cbegin(), dayIt);
+    size_t const shiftIndex = std::distance(shiftTypes.cbegin(), shiftIt);
+    slots[dayIndex * shiftTypes.size() + shiftIndex].push_back(assignment);
+  }
+  return slots;
+}
+
+size_t ScheduleExportAgent::WriteSchedule(ScAddr const & schedule, ScheduleExportWriter & writer)
+{
+  auto const weekdays = ScheduleCodes::GetWeekdays();
+  auto const shiftTypes = ScheduleCodes::GetShiftTypes();
+  auto const slots = GroupAssignmentsBySlot(schedule);
+
+  size_t written = 0;
+  writer.Begin();
+  for (size_t slotIndex = 0; slotIndex < slots.size(); ++slotIndex)
+  {
+    ScheduleExportRow row;
+    row.dayIndex = slotIndex / shiftTypes.size();
+    row.shiftIndex = slotIndex % shiftTypes.size();
+    row.dayCode = m_context.GetElementSystemIdentifier(weekdays[row.dayIndex]);
+    row.shiftCode = m_shiftCodes.FindCode(shiftTypes[row.shiftIndex]);
+
+    for (ScAddr const & assignment : slots[slotIndex])
+    {
+      ScAddr const employee = GetAttribute(assignment, SchedulingKeynodes::nrel_assigned_to_shift);
+      if (!employee.IsValid())
+        continue;
+
+      row.name = GetEmployeeName(employee);
+      row.profession = GetEmployeeProfession(employee);
+      row.uid = assignment.Hash();
+      writer.Write(row);
+      ++written;
+    }
+  }
+  writer.End();
+  return written;
+}
+
+ScResult ScheduleExportAgent::DoProgram(ScAction & action)
+{
+  auto const & [schedule, format, filePathLink, weekStartLink] = action.GetArguments<4>();
+  if (!schedule.IsValid() || !format.IsValid())
+  {
+    m_logger.Error("ScheduleExportAgent: Schedule and export format must be provided");
+    return action.FinishWithError();
+  }
+
+  if (!m_context.CheckConnector(SchedulingKeynodes::concept_schedule, schedule, ScType::ConstPermPosArc))
+  {
+    m_logger.Error("ScheduleExportAgent: Argument is not a schedule");
+    return action.FinishWithError();
+  }
+
+  m_professionCodes = ScheduleCodes::LoadProfessionMap(m_context);
+  m_shiftCodes = ScheduleCodes::LoadShiftMap(m_context);
+
+  ScStructure result = m_context.GenerateStructure();
+  std::string const filePath = GetLinkString(filePathLink);
+
+  if (!filePath.empty())
+  {
+    // Файл пишется потоком по мере обхода назначений. Он открывается (и очищается) только после того,
+    // как формат распознан, чтобы ошибочный запрос не стёр существующую выгрузку
+    std::ofstream file;
+    auto writer = CreateWriter(format, file, weekStartLink);
+    if (!writer)
+    {
+      m_logger.Error("ScheduleExportAgent: Unknown export format");
+      return action.FinishWithError();
+    }
+    file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!file)
+    {
+      m_logger.Error("ScheduleExportAgent: Cannot open file ", filePath);
+      return action.FinishWithError();
+    }
+
+    size_t const written = WriteSchedule(schedule, *writer);
+    if (!file)
+    {
+      m_logger.Error("ScheduleExportAgent: Failed to write file ", filePath);
+      return action.FinishWithError();
+    }
+
+    m_logger.Info("ScheduleExportAgent: Exported ", written, " assignments to ", filePath);
+    result << filePathLink;
+  }
+  else
+  {
+    // Содержимое sc-ссылки задаётся целиком, поэтому выгрузка собирается в буфере
+    std::ostringstream buffer;
+    auto writer = CreateWriter(format, buffer, weekStartLink);
+    if (!writer)
+    {
+      m_logger.Error("ScheduleExportAgent: Unknown export format");
+      return action.FinishWithError();
+    }
+
+    size_t const written = WriteSchedule(schedule, *writer);
+
+    ScAddr link = m_context.GenerateLink(ScType::ConstNodeLink);
+    m_context.SetLinkContent(link, buffer.str());
+    m_logger.Info("ScheduleExportAgent: Exported ", written, " assignments to sc-link");
+    result << link;
+  }
+
+  action.SetResult(result);
+  return action.FinishSuccessfully();
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <sc-memory/sc_agent.hpp>
+
+#include "utils/scheduleCodes.hpp"
+#include "utils/scheduleExportWriter.hpp"
+
+#include <memory>
+#include <vector>
+
+// Выгружает расписание в CSV или iCalendar в sc-ссылку либо в локальный файл
+class ScheduleExportAgent : public ScActionInitiatedAgent
+{
+public:
+  ScAddr GetActionClass() const override;
+  ScResult DoProgram(ScAction & action) override;
+
+private:
+  ScheduleCodes::CodeMap m_professionCodes;
+  ScheduleCodes::CodeMap m_shiftCodes;
+
+  std::string GetLinkString(ScAddr const & link);
+  std::string GetEmployeeName(ScAddr const & employee);
+  std::string GetEmployeeProfession(ScAddr const & employee);
+  ScAddr GetAttribute(ScAddr const & element, ScAddr const & relation);
+
+  std::unique_ptr<ScheduleExportWriter> CreateWriter(
+      ScAddr const & format,
+      std::ostream & out,
+      ScAddr const & weekStartLink);
+
+  std::vector<std::vector<ScAddr>> GroupAssignmentsBySlot(ScAddr const & schedule);
+  size_t WriteSchedule(ScAddr const & schedule, ScheduleExportWriter & writer);
+};
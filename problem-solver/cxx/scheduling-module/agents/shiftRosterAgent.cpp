@@ -0,0 +1,89 @@
+#include "shiftRosterAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+
+#include <sc-memory/sc_memory_headers.hpp>
+
+ScAddr ShiftRosterAgent::GetActionClass() const
+{
+  return SchedulingKeynodes::action_get_shift_roster;
+}
+
+bool ShiftRosterAgent::HasAttribute(ScAddr const & element, ScAddr const & value, ScAddr const & relation)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      element, ScType::ConstCommonArc, value, ScType::ConstPermPosArc, relation);
+  return it->Next();
+}
+
+// Ищет узел-состав среди составов расписания (их не больше, чем дней × смен)
+ScAddr ShiftRosterAgent::FindRoster(ScAddr const & schedule, ScAddr const & day, ScAddr const & shiftType)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      schedule, ScType::ConstCommonArc, ScType::ConstNode, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_shift_roster);
+  while (it->Next())
+  {
+    ScAddr roster = it->Get(2);
+    if (HasAttribute(roster, day, SchedulingKeynodes::nrel_shift_day) &&
+        HasAttribute(roster, shiftType, SchedulingKeynodes::nrel_shift_type))
+      return roster;
+  }
+  return ScAddr::Empty;
+}
+
+void ShiftRosterAgent::AddRosterEmployees(ScStructure & result, ScAddr const & roster)
+{
+  ScIterator3Ptr it = m_context.CreateIterator3(roster, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it->Next())
+    result << it->Get(2);
+}
+
+// Расписания без индекса составов: просматриваем все назначения
+void ShiftRosterAgent::AddAssignedEmployees(
+    ScStructure & result,
+    ScAddr const & schedule,
+    ScAddr const & day,
+    ScAddr const & shiftType)
+{
+  ScIterator3Ptr it = m_context.CreateIterator3(schedule, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (it->Next())
+  {
+    ScAddr assignment = it->Get(2);
+    if (!m_context.CheckConnector(SchedulingKeynodes::concept_shift_assignment, assignment, ScType::ConstPermPosArc))
+      continue;
+
+    if (!HasAttribute(assignment, day, SchedulingKeynodes::nrel_shift_day) ||
+        !HasAttribute(assignment, shiftType, SchedulingKeynodes::nrel_shift_type))
+      continue;
+
+    ScIterator5Ptr itEmployee = m_context.CreateIterator5(
+        assignment, ScType::ConstCommonArc, ScType::ConstNode, ScType::ConstPermPosArc,
+        SchedulingKeynodes::nrel_assigned_to_shift);
+    if (itEmployee->Next())
+      result << itEmployee->Get(2);
+  }
+}
+
+ScResult ShiftRosterAgent::DoProgram(ScAction & action)
+{
+  auto const & [schedule, day, shiftType] = action.GetArguments<3>();
+  if (!schedule.IsValid() || !day.IsValid() || !shiftType.IsValid())
+  {
+    m_logger.Error("ShiftRosterAgent: Schedule, day and shift type must be provided");
+    return action.FinishWithError();
+  }
+
+  ScStructure result = m_context.GenerateStructure();
+
+  ScAddr roster = FindRoster(schedule, day, shiftType);
+  if (roster.IsValid())
+    AddRosterEmployees(result, roster);
+  else
+  {
+    m_logger.Warning("ShiftRosterAgent: Schedule has no roster index, scanning assignments");
+    AddAssignedEmployees(result, schedule, day, shiftType);
+  }
+
+  action.SetResult(result);
+  return action.FinishSuccessfully();
+}
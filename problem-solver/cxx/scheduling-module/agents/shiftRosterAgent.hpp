@@ -0,0 +1,21 @@
+#pragma once
+
+#include <sc-memory/sc_agent.hpp>
+
+// Возвращает сотрудников, назначенных на смену заданного типа в заданный день
+class ShiftRosterAgent : public ScActionInitiatedAgent
+{
+public:
+  ScAddr GetActionClass() const override;
+  ScResult DoProgram(ScAction & action) override;
+
+private:
+  bool HasAttribute(ScAddr const & element, ScAddr const & value, ScAddr const & relation);
+  ScAddr FindRoster(ScAddr const & schedule, ScAddr const & day, ScAddr const & shiftType);
+  void AddRosterEmployees(ScStructure & result, ScAddr const & roster);
+  void AddAssignedEmployees(
+      ScStructure & result,
+      ScAddr const & schedule,
+      ScAddr const & day,
+      ScAddr const & shiftType);
+};
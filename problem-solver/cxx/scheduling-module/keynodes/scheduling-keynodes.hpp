@@ -10,6 +10,17 @@ public:
     "action_build_weekly_schedule", ScType::ConstNodeClass};
   static inline ScKeynode const action_import_staff_from_csv{
     "action_import_staff_from_csv", ScType::ConstNodeClass};
+  static inline ScKeynode const action_import_staff_from_jsonl{
+    "action_import_staff_from_jsonl", ScType::ConstNodeClass};
+  static inline ScKeynode const action_import_staff_from_snapshot{
+    "action_import_staff_from_snapshot", ScType::ConstNodeClass};
+  static inline ScKeynode const action_export_staff_snapshot{
+    "action_export_staff_snapshot", ScType::ConstNodeClass};
+  static inline ScKeynode const action_get_shift_roster{"action_get_shift_roster", ScType::ConstNodeClass};
+  static inline ScKeynode const action_get_employee_timetable{
+    "action_get_employee_timetable", ScType::ConstNodeClass};
+  static inline ScKeynode const action_export_schedule{"action_export_schedule", ScType::ConstNodeClass};
+  static inline ScKeynode const action_schedule_build_job{"action_schedule_build_job", ScType::ConstNodeClass};
 
   // Professions
   static inline ScKeynode const concept_employee{"concept_employee", ScType::ConstNodeClass};
@@ -32,6 +43,13 @@ public:
   static inline ScKeynode const nrel_can_not_work{"nrel_can_not_work", ScType::ConstNodeNonRole};
   static inline ScKeynode const nrel_workload{"nrel_workload", ScType::ConstNodeNonRole};
   static inline ScKeynode const nrel_file_content{"nrel_file_content", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_file_path{"nrel_file_path", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_csv_delimiter{"nrel_csv_delimiter", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_employee_id{"nrel_employee_id", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_profession_code{"nrel_profession_code", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_shift_code{"nrel_shift_code", ScType::ConstNodeNonRole};
+  static inline ScKeynode const import_staff_upsert{"import_staff_upsert", ScType::ConstNode};
+  static inline ScKeynode const import_staff_atomic{"import_staff_atomic", ScType::ConstNode};
 
   // Weekdays
   static inline ScKeynode const concept_weekday{"concept_weekday", ScType::ConstNodeClass};
@@ -46,11 +64,55 @@ public:
   // Schedule structure
   static inline ScKeynode const concept_schedule{"concept_schedule", ScType::ConstNodeClass};
   static inline ScKeynode const concept_shift_assignment{"concept_shift_assignment", ScType::ConstNodeClass};
+  static inline ScKeynode const current_schedule{"current_schedule", ScType::ConstNode};  // Последнее опубликованное расписание
   
   // Shift requirements
   static inline ScKeynode const concept_shift_requirements{"concept_shift_requirements", ScType::ConstNodeClass};
   static inline ScKeynode const nrel_required_count{"nrel_required_count", ScType::ConstNodeNonRole};
   static inline ScKeynode const nrel_max_shifts_per_week{"nrel_max_shifts_per_week", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_max_stored_schedules{"nrel_max_stored_schedules", ScType::ConstNodeNonRole};
+
+  // Schedule history (история построенных расписаний)
+  static inline ScKeynode const nrel_schedule_requirements{"nrel_schedule_requirements", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_schedule_version{"nrel_schedule_version", ScType::ConstNodeNonRole};
+
+  // Input fingerprint (повторное использование расписания при неизменных входных данных)
+  static inline ScKeynode const nrel_input_fingerprint{"nrel_input_fingerprint", ScType::ConstNodeNonRole};
+  static inline ScKeynode const schedule_rebuild_forced{"schedule_rebuild_forced", ScType::ConstNode};
+
+  // Asynchronous building (асинхронное построение на пуле потоков)
+  static inline ScKeynode const schedule_build_async{"schedule_build_async", ScType::ConstNode};
+  static inline ScKeynode const nrel_max_concurrent_builds{"nrel_max_concurrent_builds", ScType::ConstNodeNonRole};
+
+  // Parallel persistence (параллельная запись результата через несколько контекстов)
+  static inline ScKeynode const schedule_parallel_persistence{"schedule_parallel_persistence", ScType::ConstNode};
+  static inline ScKeynode const nrel_persistence_writers{"nrel_persistence_writers", ScType::ConstNodeNonRole};
+
+  // Diff-based schedule persistence (сохранение только изменений расписания)
+  static inline ScKeynode const schedule_persistence_diff{"schedule_persistence_diff", ScType::ConstNode};
+  static inline ScKeynode const concept_schedule_diff{"concept_schedule_diff", ScType::ConstNodeClass};
+  static inline ScKeynode const nrel_schedule_diff{"nrel_schedule_diff", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_previous_schedule{"nrel_previous_schedule", ScType::ConstNodeNonRole};
+  static inline ScKeynode const rrel_added_assignment{"rrel_added_assignment", ScType::ConstNodeRole};
+  static inline ScKeynode const rrel_removed_assignment{"rrel_removed_assignment", ScType::ConstNodeRole};
+  static inline ScKeynode const rrel_changed_workload{"rrel_changed_workload", ScType::ConstNodeRole};
+
+  // Compact schedule encoding (компактное представление расписания в одной ссылке)
+  static inline ScKeynode const schedule_encoding_binary{"schedule_encoding_binary", ScType::ConstNode};
+  static inline ScKeynode const nrel_schedule_encoding{"nrel_schedule_encoding", ScType::ConstNodeNonRole};
+
+  // Roster index (состав смены по дню и типу смены)
+  static inline ScKeynode const concept_shift_roster{"concept_shift_roster", ScType::ConstNodeClass};
+  static inline ScKeynode const nrel_shift_roster{"nrel_shift_roster", ScType::ConstNodeNonRole};
+
+  // Employee timetable index (недельный график сотрудника)
+  static inline ScKeynode const concept_employee_timetable{"concept_employee_timetable", ScType::ConstNodeClass};
+  static inline ScKeynode const nrel_timetable_employee{"nrel_timetable_employee", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_shift_mask{"nrel_shift_mask", ScType::ConstNodeNonRole};
+
+  // Schedule export (выгрузка расписания в CSV и iCalendar)
+  static inline ScKeynode const schedule_export_csv{"schedule_export_csv", ScType::ConstNode};
+  static inline ScKeynode const schedule_export_ics{"schedule_export_ics", ScType::ConstNode};
   
   // Bipartite graph (двудольный граф)
   static inline ScKeynode const concept_bipartite_graph{"concept_bipartite_graph", ScType::ConstNodeClass};
@@ -59,4 +121,13 @@ public:
   static inline ScKeynode const nrel_right_part{"nrel_right_part", ScType::ConstNodeNonRole}; // Правая доля (слоты)
   static inline ScKeynode const nrel_can_work{"nrel_can_work", ScType::ConstNodeNonRole};     // Ребро графа: сотрудник может работать в слоте
   static inline ScKeynode const nrel_slot_profession{"nrel_slot_profession", ScType::ConstNodeNonRole};
+  static inline ScKeynode const nrel_slot_position{"nrel_slot_position", ScType::ConstNodeNonRole};
+
+  // Bipartite graph persistence levels (уровень сохранения двудольного графа)
+  static inline ScKeynode const concept_graph_persistence_level{
+    "concept_graph_persistence_level", ScType::ConstNodeClass};
+  static inline ScKeynode const graph_persistence_none{"graph_persistence_none", ScType::ConstNode};
+  static inline ScKeynode const graph_persistence_matched_edges{
+    "graph_persistence_matched_edges", ScType::ConstNode};
+  static inline ScKeynode const graph_persistence_full{"graph_persistence_full", ScType::ConstNode};
 };
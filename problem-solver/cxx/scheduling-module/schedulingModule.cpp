@@ -2,7 +2,27 @@
 
 #include "agents/scheduleBuilderAgent.hpp"
 #include "agents/importStaffAgent.hpp"
+#include "agents/importStaffFromJsonlAgent.hpp"
+#include "agents/importStaffFromSnapshotAgent.hpp"
+#include "agents/exportStaffSnapshotAgent.hpp"
+#include "agents/shiftRosterAgent.hpp"
+#include "agents/employeeTimetableAgent.hpp"
+#include "agents/scheduleExportAgent.hpp"
+#include "utils/buildWorkerPool.hpp"
 
 SC_MODULE_REGISTER(SchedulingModule)
     ->Agent<ScheduleBuilderAgent>()
-    ->Agent<ImportStaffAgent>();
+    ->Agent<ImportStaffAgent>()
+    ->Agent<ImportStaffFromJsonlAgent>()
+    ->Agent<ImportStaffFromSnapshotAgent>()
+    ->Agent<ExportStaffSnapshotAgent>()
+    ->Agent<ShiftRosterAgent>()
+    ->Agent<EmployeeTimetableAgent>()
+    ->Agent<ScheduleExportAgent>();
+
+// Асинхронные построения должны завершиться до остановки SC-memory
+void SchedulingModule::Shutdown(ScMemoryContext * context)
+{
+  BuildWorkerPool::GetInstance().Shutdown();
+  ScModule::Shutdown(context);
+}
@@ -4,4 +4,6 @@
 
 class SchedulingModule : public ScModule
 {
+public:
+  void Shutdown(ScMemoryContext * context) override;
 };
@@ -0,0 +1,158 @@
+#include "utils/parallelShards.hpp"
+#include "utils/staffCsvReader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Замер скорости разбора CSV-файла штата.
+// Аргументы: [число строк (по умолчанию 1000000)] [путь к CSV-файлу вместо сгенерированного]
+
+namespace
+{
+
+std::string GenerateStaffCsv(size_t rows)
+{
+  char const * professions[] = {"повар", "официант", "уборщик", "администратор"};
+  char const * shifts[] = {"M;D", "D;N", "M;D;N", "", "N"};
+
+  std::string data = "profession,name,allowed_shifts,forbidden_shifts\n";
+  data.reserve(rows * 48);
+  for (size_t i = 0; i < rows; ++i)
+  {
+    data += professions[i % 4];
+    // Каждое десятое имя в кавычках с разделителем внутри
+    data += i % 10 == 0 ? ",\"Сотрудник, " : ",Сотрудник ";
+    data += std::to_string(i);
+    data += i % 10 == 0 ? "\"," : ",";
+    data += shifts[i % 5];
+    data += ',';
+    data += shifts[(i + 3) % 5];
+    data += '\n';
+  }
+  return data;
+}
+
+std::string ReadFile(std::string const & path)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+struct ParseStats
+{
+  size_t rows = 0;
+  size_t shiftCodes = 0;
+};
+
+ParseStats ParseChunk(std::string_view data, bool hasHeader)
+{
+  ParseStats stats;
+  StaffCsvReader reader(data);
+  CsvFields fields;
+  if (hasHeader)
+    reader.NextRecord(fields);
+
+  CsvFormat format;
+  format.columnCount = 4;
+  StaffCsvRecord record;
+  auto const countCode = [&stats](std::string_view) {
+    stats.shiftCodes++;
+  };
+  while (reader.NextRecord(fields))
+  {
+    StaffCsvReader::ParseRow(fields, format, record);
+    StaffCsvReader::ForEachShiftCode(record.allowedShifts, countCode);
+    StaffCsvReader::ForEachShiftCode(record.forbiddenShifts, countCode);
+    stats.rows++;
+  }
+  return stats;
+}
+
+ParseStats ParseWithReader(std::string const & data)
+{
+  return ParseChunk(data, true);
+}
+
+// Части, выровненные по концам записей, разбираются одновременно, как в ImportStaffAgent
+ParseStats ParseWithChunks(std::string const & data)
+{
+  std::string_view const body = std::string_view(data).substr(data.find('\n') + 1);
+  auto const chunks = StaffCsvReader::SplitChunks(body, std::max(std::thread::hardware_concurrency(), 1u));
+
+  std::vector<ParseStats> chunkStats(chunks.size());
+  RunShards(chunks.size(), [&](size_t chunk) {
+    chunkStats[chunk] = ParseChunk(chunks[chunk], false);
+  });
+
+  ParseStats stats;
+  for (auto const & chunk : chunkStats)
+  {
+    stats.rows += chunk.rows;
+    stats.shiftCodes += chunk.shiftCodes;
+  }
+  return stats;
+}
+
+// Прежний способ разбора: копия строки в поток и по строковому потоку на каждую строку
+ParseStats ParseWithStreams(std::string const & data)
+{
+  ParseStats stats;
+  std::istringstream dataStream(data);
+  std::string line;
+  std::getline(dataStream, line);
+  while (std::getline(dataStream, line))
+  {
+    std::stringstream row(line);
+    std::string profession, name, allowed, forbidden;
+    std::getline(row, profession, ',');
+    std::getline(row, name, ',');
+    std::getline(row, allowed, ',');
+    std::getline(row, forbidden, ',');
+    for (std::string const & shifts : {allowed, forbidden})
+    {
+      std::stringstream codes(shifts);
+      std::string code;
+      while (std::getline(codes, code, ';'))
+      {
+        if (!code.empty())
+          stats.shiftCodes++;
+      }
+    }
+    stats.rows++;
+  }
+  return stats;
+}
+
+template <typename TParse>
+void Measure(std::string const & title, std::string const & data, TParse && parse)
+{
+  auto const started = std::chrono::steady_clock::now();
+  ParseStats const stats = parse(data);
+  double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  std::cout << title << ": " << stats.rows << " rows, " << stats.shiftCodes << " shift codes, " << seconds
+            << " s, " << stats.rows / seconds << " rows/s, " << data.size() / seconds / (1024 * 1024) << " MiB/s"
+            << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  size_t const rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::string const data = argc > 2 ? ReadFile(argv[2]) : GenerateStaffCsv(rows);
+
+  std::cout << "Input: " << data.size() / (1024 * 1024) << " MiB" << std::endl;
+  Measure("StaffCsvReader", data, ParseWithReader);
+  Measure("StaffCsvReader, " + std::to_string(std::thread::hardware_concurrency()) + " chunks", data, ParseWithChunks);
+  Measure("std::stringstream", data, ParseWithStreams);
+  return 0;
+}
@@ -0,0 +1,125 @@
+#include "utils/parallelShards.hpp"
+#include "utils/staffJsonlReader.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+// Замер скорости разбора штата в формате JSON Lines, те же данные, что и в staffCsvReaderBenchmark.
+// Аргументы: [число строк (по умолчанию 1000000)] [путь к JSONL-файлу вместо сгенерированного]
+
+namespace
+{
+
+std::string GenerateStaffJsonl(size_t rows)
+{
+  char const * professions[] = {"повар", "официант", "уборщик", "администратор"};
+  char const * shifts[] = {"\"M;D\"", "[\"D\", \"N\"]", "\"M;D;N\"", "\"\"", "[\"N\"]"};
+
+  std::string data;
+  data.reserve(rows * 110);
+  for (size_t i = 0; i < rows; ++i)
+  {
+    data += "{\"id\": ";
+    data += std::to_string(i);
+    data += ", \"profession\": \"";
+    data += professions[i % 4];
+    // Каждое десятое имя с экранированными кавычками
+    data += i % 10 == 0 ? "\", \"name\": \"Сотрудник \\\"" : "\", \"name\": \"Сотрудник ";
+    data += std::to_string(i);
+    data += i % 10 == 0 ? "\\\"\", \"allowed_shifts\": " : "\", \"allowed_shifts\": ";
+    data += shifts[i % 5];
+    data += ", \"forbidden_shifts\": ";
+    data += shifts[(i + 3) % 5];
+    data += "}\n";
+  }
+  return data;
+}
+
+std::string ReadFile(std::string const & path)
+{
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+  return content.str();
+}
+
+struct ParseStats
+{
+  size_t rows = 0;
+  size_t shiftCodes = 0;
+  size_t invalid = 0;
+};
+
+ParseStats ParseChunk(std::string_view data)
+{
+  ParseStats stats;
+  StaffJsonlReader reader(data);
+  StaffCsvRecord record;
+  auto const countCode = [&stats](std::string_view) {
+    stats.shiftCodes++;
+  };
+  while (reader.NextRecord(record))
+  {
+    StaffCsvReader::ForEachShiftCode(record.allowedShifts, countCode);
+    StaffCsvReader::ForEachShiftCode(record.forbiddenShifts, countCode);
+    stats.rows++;
+  }
+  stats.invalid = reader.GetInvalidCount();
+  return stats;
+}
+
+ParseStats ParseWithReader(std::string const & data)
+{
+  return ParseChunk(data);
+}
+
+// Части по переводам строк разбираются одновременно, как в ImportStaffFromJsonlAgent
+ParseStats ParseWithChunks(std::string const & data)
+{
+  auto const chunks = StaffJsonlReader::SplitChunks(data, std::max(std::thread::hardware_concurrency(), 1u));
+
+  std::vector<ParseStats> chunkStats(chunks.size());
+  RunShards(chunks.size(), [&](size_t chunk) {
+    chunkStats[chunk] = ParseChunk(chunks[chunk]);
+  });
+
+  ParseStats stats;
+  for (auto const & chunk : chunkStats)
+  {
+    stats.rows += chunk.rows;
+    stats.shiftCodes += chunk.shiftCodes;
+    stats.invalid += chunk.invalid;
+  }
+  return stats;
+}
+
+template <typename TParse>
+void Measure(std::string const & title, std::string const & data, TParse && parse)
+{
+  auto const started = std::chrono::steady_clock::now();
+  ParseStats const stats = parse(data);
+  double const seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+  std::cout << title << ": " << stats.rows << " rows (" << stats.invalid << " invalid), " << stats.shiftCodes
+            << " shift codes, " << seconds << " s, " << stats.rows / seconds << " rows/s, "
+            << data.size() / seconds / (1024 * 1024) << " MiB/s" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char ** argv)
+{
+  size_t const rows = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+  std::string const data = argc > 2 ? ReadFile(argv[2]) : GenerateStaffJsonl(rows);
+
+  std::cout << "Input: " << data.size() / (1024 * 1024) << " MiB" << std::endl;
+  Measure("StaffJsonlReader", data, ParseWithReader);
+  Measure("StaffJsonlReader, " + std::to_string(std::thread::hardware_concurrency()) + " chunks", data, ParseWithChunks);
+  return 0;
+}
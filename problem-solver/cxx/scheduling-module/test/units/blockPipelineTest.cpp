@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "utils/blockPipeline.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <vector>
+
+TEST(BlockPipelineTest, ConsumesBlocksInOrder)
+{
+  std::vector<int> produced(5, 0);
+  std::vector<size_t> consumed;
+
+  RunBlockPipeline(
+      produced.size(),
+      [&produced](size_t block) { produced[block] = static_cast<int>(block) * 10; },
+      [&produced, &consumed](size_t block) {
+        EXPECT_EQ(produced[block], static_cast<int>(block) * 10);
+        consumed.push_back(block);
+      });
+
+  EXPECT_EQ(consumed, (std::vector<size_t>{0, 1, 2, 3, 4}));
+}
+
+TEST(BlockPipelineTest, ProducerRunsWhileConsumerWorks)
+{
+  std::atomic<size_t> producedCount{0};
+  size_t producedWhileConsumingFirst = 0;
+
+  RunBlockPipeline(
+      3,
+      [&producedCount](size_t) { ++producedCount; },
+      [&producedCount, &producedWhileConsumingFirst](size_t block) {
+        if (block != 0)
+          return;
+        auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (producedCount < 3 && std::chrono::steady_clock::now() < deadline)
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        producedWhileConsumingFirst = producedCount;
+      });
+
+  EXPECT_EQ(producedWhileConsumingFirst, 3u);
+}
+
+TEST(BlockPipelineTest, PropagatesErrors)
+{
+  EXPECT_THROW(
+      RunBlockPipeline(
+          3,
+          [](size_t block) {
+            if (block == 1)
+              throw std::runtime_error("solver failed");
+          },
+          [](size_t) {}),
+      std::runtime_error);
+
+  EXPECT_THROW(
+      RunBlockPipeline(
+          3, [](size_t) {}, [](size_t) { throw std::logic_error("persistence failed"); }),
+      std::logic_error);
+}
@@ -0,0 +1,57 @@
+#include <gtest/gtest.h>
+
+#include "utils/buildWorkerPool.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+TEST(BuildWorkerPoolTest, RunsAllTasks)
+{
+  BuildWorkerPool pool;
+  std::atomic<int> completed{0};
+
+  for (int i = 0; i < 20; ++i)
+    pool.Submit([&completed] { ++completed; });
+
+  pool.Shutdown();
+  EXPECT_EQ(completed.load(), 20);
+}
+
+TEST(BuildWorkerPoolTest, RespectsConcurrencyLimit)
+{
+  BuildWorkerPool pool;
+  pool.SetConcurrencyLimit(2);
+
+  std::atomic<int> running{0};
+  std::atomic<int> maxRunning{0};
+  for (int i = 0; i < 8; ++i)
+  {
+    pool.Submit([&running, &maxRunning] {
+      int const current = ++running;
+      int observed = maxRunning.load();
+      while (current > observed && !maxRunning.compare_exchange_weak(observed, current))
+        ;
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      --running;
+    });
+  }
+
+  pool.Shutdown();
+  EXPECT_EQ(maxRunning.load(), 2);
+}
+
+TEST(BuildWorkerPoolTest, ReusableAfterShutdownAndSurvivesExceptions)
+{
+  BuildWorkerPool pool;
+  std::atomic<int> completed{0};
+
+  pool.Submit([] { throw std::runtime_error("build failed"); });
+  pool.Submit([&completed] { ++completed; });
+  pool.Shutdown();
+
+  pool.Submit([&completed] { ++completed; });
+  pool.Shutdown();
+  EXPECT_EQ(completed.load(), 2);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "utils/csvScanner.hpp"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::vector<CsvScanMode> GetSupportedModes()
+{
+  std::vector<CsvScanMode> modes;
+  for (CsvScanMode mode : {CsvScanMode::Scalar, CsvScanMode::Sse2, CsvScanMode::Avx2})
+  {
+    if (CsvScanner::IsSupported(mode))
+      modes.push_back(mode);
+  }
+  return modes;
+}
+
+}  // namespace
+
+TEST(CsvScannerTest, FindStructural_FindsEachStructuralCharacter)
+{
+  std::string const data = std::string(40, 'x') + "," + std::string(20, 'y') + "\"z\r\n";
+  for (CsvScanMode mode : GetSupportedModes())
+  {
+    EXPECT_EQ(CsvScanner::FindStructural(data, 0, ',', mode), 40u);
+    EXPECT_EQ(CsvScanner::FindStructural(data, 41, ',', mode), 61u);
+    EXPECT_EQ(CsvScanner::FindStructural(data, 62, ',', mode), 63u);
+    EXPECT_EQ(CsvScanner::FindStructural(data, 64, ',', mode), 64u);
+    EXPECT_EQ(CsvScanner::FindStructural(data, 0, ';', mode), 61u);
+    EXPECT_EQ(CsvScanner::FindStructural(data, data.size(), ',', mode), data.size());
+    EXPECT_EQ(CsvScanner::FindStructural("без разделителей", 0, ',', mode), std::string("без разделителей").size());
+  }
+}
+
+TEST(CsvScannerTest, FindStructural_VectorModesMatchScalar)
+{
+  std::mt19937 random(42);
+  std::string const alphabet = "ab ,;\"\r\nпд";
+  std::string data(4096, ' ');
+  for (char & c : data)
+  {
+    // Редкие структурные символы, чтобы проверить длинные проходы без совпадений
+    c = random() % 16 == 0 ? alphabet[random() % alphabet.size()] : 'x';
+  }
+
+  for (CsvScanMode mode : GetSupportedModes())
+  {
+    for (size_t from = 0; from <= data.size(); from += 7)
+    {
+      EXPECT_EQ(
+          CsvScanner::FindStructural(data, from, ';', mode),
+          CsvScanner::FindStructural(data, from, ';', CsvScanMode::Scalar));
+    }
+  }
+}
@@ -0,0 +1,162 @@
+#include <sc-memory/test/sc_test.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "agents/employeeTimetableAgent.hpp"
+#include "agents/scheduleBuilderAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/TestUtils.hpp"
+#include "utils/scheduleEncoding.hpp"
+
+using EmployeeTimetableAgentTest = ScMemoryTest;
+
+namespace
+{
+
+ScAddr BuildSchedule(ScAgentContext & ctx)
+{
+  ScAddr requirements = TestUtils::CreateShiftRequirements(ctx, 1, 1, 0, 0, 7);
+  ScAction buildAction = TestUtils::CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(buildAction.InitiateAndWait(10000));
+  EXPECT_TRUE(buildAction.IsFinishedSuccessfully());
+  return buildAction.GetResult();
+}
+
+}  // namespace
+
+TEST_F(EmployeeTimetableAgentTest, GetTimetable_ReturnsMaskAndAssignments)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<EmployeeTimetableAgent>();
+
+  // Повар работает только утром — по одной утренней смене каждый день
+  ScAddr cook = TestUtils::CreateEmployee(
+      ctx, "ПоварУтро", SchedulingKeynodes::concept_cook, {SchedulingKeynodes::concept_morning_shift});
+  TestUtils::CreateEmployee(ctx, "Официант1", SchedulingKeynodes::concept_waiter);
+
+  ScAddr schedule = BuildSchedule(ctx);
+
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_get_employee_timetable);
+  action.SetArguments(cook, schedule);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  ScAddr result = action.GetResult();
+  uint32_t expectedMask = 0;
+  for (size_t day = 0; day < 7; ++day)
+    expectedMask |= ScheduleEncoding::GetShiftBit(day, 0, 3);
+
+  int assignmentCount = 0;
+  std::string mask;
+  ScIterator3Ptr it = ctx.CreateIterator3(result, ScType::ConstPermPosArc, ScType::Unknown);
+  while (it->Next())
+  {
+    ScAddr element = it->Get(2);
+    if (ctx.CheckConnector(SchedulingKeynodes::concept_shift_assignment, element, ScType::ConstPermPosArc))
+      assignmentCount++;
+    else if (ctx.GetElementType(element).IsLink())
+      ctx.GetLinkContent(element, mask);
+  }
+
+  EXPECT_EQ(assignmentCount, 7);
+  EXPECT_EQ(mask, std::to_string(expectedMask));
+
+  ctx.UnsubscribeAgent<EmployeeTimetableAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(EmployeeTimetableAgentTest, GetTimetable_UnknownEmployee)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<EmployeeTimetableAgent>();
+
+  TestUtils::CreateEmployee(ctx, "Повар1", SchedulingKeynodes::concept_cook);
+  TestUtils::CreateEmployee(ctx, "Официант1", SchedulingKeynodes::concept_waiter);
+  ScAddr schedule = BuildSchedule(ctx);
+
+  ScAddr stranger = ctx.GenerateNode(ScType::ConstNode);
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_get_employee_timetable);
+  action.SetArguments(stranger, schedule);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedUnsuccessfully());
+
+  ctx.UnsubscribeAgent<EmployeeTimetableAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(EmployeeTimetableAgentTest, GetTimetable_DefaultsToCurrentSchedule)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<EmployeeTimetableAgent>();
+
+  ScAddr cook = TestUtils::CreateEmployee(
+      ctx, "ПоварУтро", SchedulingKeynodes::concept_cook, {SchedulingKeynodes::concept_morning_shift});
+  TestUtils::CreateEmployee(ctx, "Официант1", SchedulingKeynodes::concept_waiter);
+
+  // Расписание ещё не опубликовано
+  ScAction emptyAction = ctx.GenerateAction(SchedulingKeynodes::action_get_employee_timetable);
+  emptyAction.SetArguments(cook);
+  EXPECT_TRUE(emptyAction.InitiateAndWait(5000));
+  EXPECT_TRUE(emptyAction.IsFinishedUnsuccessfully());
+
+  BuildSchedule(ctx);
+
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_get_employee_timetable);
+  action.SetArguments(cook);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  ctx.UnsubscribeAgent<EmployeeTimetableAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(EmployeeTimetableAgentTest, GetTimetable_ResultDoesNotRetainSupersededSchedule)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<EmployeeTimetableAgent>();
+
+  ScAddr cook = TestUtils::CreateEmployee(ctx, "Повар1", SchedulingKeynodes::concept_cook);
+  TestUtils::CreateEmployee(ctx, "Официант1", SchedulingKeynodes::concept_waiter);
+
+  // Хранится только последнее расписание
+  ScAddr requirements = TestUtils::CreateShiftRequirements(ctx, 1, 1, 0, 0, 7);
+  ScAddr storedLink = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(storedLink, "1");
+  ScAddr arcStored = ctx.GenerateConnector(ScType::ConstCommonArc, requirements, storedLink);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_max_stored_schedules, arcStored);
+
+  ScAction firstBuild = TestUtils::CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(firstBuild.InitiateAndWait(10000));
+  EXPECT_TRUE(firstBuild.IsFinishedSuccessfully());
+  ScAddr oldSchedule = firstBuild.GetResult();
+
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_get_employee_timetable);
+  action.SetArguments(cook, oldSchedule);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  std::vector<ScAddr> queried;
+  ScIterator3Ptr it = ctx.CreateIterator3(action.GetResult(), ScType::ConstPermPosArc, ScType::Unknown);
+  while (it->Next())
+    queried.push_back(it->Get(2));
+  ASSERT_FALSE(queried.empty());
+
+  // Новое построение удаляет прежнее расписание вместе с графиком, хотя он входит в результат запроса
+  ScAction secondBuild = TestUtils::CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_rebuild_forced});
+  EXPECT_TRUE(secondBuild.InitiateAndWait(10000));
+  EXPECT_TRUE(secondBuild.IsFinishedSuccessfully());
+
+  EXPECT_FALSE(ctx.IsElement(oldSchedule));
+  for (ScAddr const & element : queried)
+    EXPECT_FALSE(ctx.IsElement(element));
+
+  ctx.UnsubscribeAgent<EmployeeTimetableAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
@@ -6,6 +6,9 @@
 #include "keynodes/scheduling-keynodes.hpp"
 #include "utils/TestUtils.hpp"
 
+#include <filesystem>
+#include <fstream>
+
 using ImportStaffAgentTest = ScMemoryTest;
 
 namespace
@@ -41,6 +44,23 @@ std::string const TEST_CSV_WITH_WHITESPACE =
     "profession,name,allowed_shifts\n"
     "  повар  ,  Пробельный  ,  M ; D  \n";
 
+// Создаёт действие импорта с содержимым CSV; дополнительные параметры добавляются в действие
+ScAction CreateImportAction(ScAgentContext & ctx, std::string const & csv, std::vector<ScAddr> const & options = {})
+{
+  ScAddr action = ctx.GenerateNode(ScType::ConstNode);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_import_staff_from_csv, action);
+
+  ScAddr link = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(link, csv);
+  ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, action, link);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_file_content, arc);
+
+  for (ScAddr const & option : options)
+    ctx.GenerateConnector(ScType::ConstPermPosArc, action, option);
+
+  return ctx.ConvertToAction(action);
+}
+
 }  // namespace
 
 // ====== БАЗОВЫЕ ТЕСТЫ ======
@@ -410,3 +430,389 @@ TEST_F(ImportStaffAgentTest, ImportStaff_FullTaskExample)
 
   m_ctx->UnsubscribeAgent<ImportStaffAgent>();
 }
+
+// ====== ТЕСТЫ ДИАЛЕКТА CSV ======
+
+TEST_F(ImportStaffAgentTest, ImportStaff_QuotedFieldsAndDelimiter)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  // BOM, CRLF, разделитель ';' и имя с разделителем и переводом строки в кавычках
+  std::string csv = 
+      "\xEF\xBB\xBFprofession;name;allowed_shifts\r\n"
+      "повар;\"Петров; Иван\";\"M;D\"\r\n"
+      "официант;\"Анна \"\"Младшая\"\"\nСмирнова\";N\r\n";
+
+  ScAddr action = m_ctx->GenerateNode(ScType::ConstNode);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_import_staff_from_csv, action);
+
+  ScAddr link = m_ctx->GenerateLink(ScType::ConstNodeLink);
+  m_ctx->SetLinkContent(link, csv);
+  ScAddr arc = m_ctx->GenerateConnector(ScType::ConstCommonArc, action, link);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_file_content, arc);
+
+  ScAddr delimiterLink = m_ctx->GenerateLink(ScType::ConstNodeLink);
+  m_ctx->SetLinkContent(delimiterLink, std::string(";"));
+  ScAddr delimiterArc = m_ctx->GenerateConnector(ScType::ConstCommonArc, action, delimiterLink);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_csv_delimiter, delimiterArc);
+
+  ScAction scAction = m_ctx->ConvertToAction(action);
+  EXPECT_TRUE(scAction.InitiateAndWait(5000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+
+  ScAddr cook = TestUtils::FindEmployeeByName(*m_ctx, "Петров; Иван");
+  EXPECT_TRUE(cook.IsValid());
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, cook), 2);
+
+  ScAddr waiter = TestUtils::FindEmployeeByName(*m_ctx, "Анна \"Младшая\"\nСмирнова");
+  EXPECT_TRUE(waiter.IsValid());
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, waiter, SchedulingKeynodes::concept_night_shift));
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+// ====== ТЕСТЫ ИМПОРТА ИЗ ФАЙЛА ======
+
+TEST_F(ImportStaffAgentTest, ImportStaff_FromFilePath)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  std::string const path = (std::filesystem::temp_directory_path() / "import_staff_agent_test.csv").string();
+  std::ofstream(path, std::ios::binary) << TEST_CSV_DATA;
+
+  ScAddr action = m_ctx->GenerateNode(ScType::ConstNode);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_import_staff_from_csv, action);
+
+  ScAddr link = m_ctx->GenerateLink(ScType::ConstNodeLink);
+  m_ctx->SetLinkContent(link, path);
+  ScAddr arc = m_ctx->GenerateConnector(ScType::ConstCommonArc, action, link);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_file_path, arc);
+
+  ScAction scAction = m_ctx->ConvertToAction(action);
+  EXPECT_TRUE(scAction.InitiateAndWait(5000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+
+  EXPECT_TRUE(TestUtils::FindEmployeeByName(*m_ctx, "Захаренков").IsValid());
+  EXPECT_TRUE(TestUtils::FindEmployeeByName(*m_ctx, "Лойко").IsValid());
+  EXPECT_TRUE(TestUtils::FindEmployeeByName(*m_ctx, "Шумилов").IsValid());
+
+  std::filesystem::remove(path);
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, ImportStaff_MissingFile)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  ScAddr action = m_ctx->GenerateNode(ScType::ConstNode);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_import_staff_from_csv, action);
+
+  ScAddr link = m_ctx->GenerateLink(ScType::ConstNodeLink);
+  m_ctx->SetLinkContent(link, std::string("/nonexistent/staff.csv"));
+  ScAddr arc = m_ctx->GenerateConnector(ScType::ConstCommonArc, action, link);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_file_path, arc);
+
+  ScAction scAction = m_ctx->ConvertToAction(action);
+  EXPECT_TRUE(scAction.InitiateAndWait(5000));
+  EXPECT_TRUE(scAction.IsFinishedWithError());
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, ImportStaff_EmptyFile)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  // Пустой файл открывается успешно и содержит ноль строк
+  std::string const path = (std::filesystem::temp_directory_path() / "import_staff_agent_empty_test.csv").string();
+  std::ofstream(path, std::ios::binary | std::ios::trunc).close();
+
+  ScAddr action = m_ctx->GenerateNode(ScType::ConstNode);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_import_staff_from_csv, action);
+
+  ScAddr link = m_ctx->GenerateLink(ScType::ConstNodeLink);
+  m_ctx->SetLinkContent(link, path);
+  ScAddr arc = m_ctx->GenerateConnector(ScType::ConstCommonArc, action, link);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_file_path, arc);
+
+  ScAction scAction = m_ctx->ConvertToAction(action);
+  EXPECT_TRUE(scAction.InitiateAndWait(5000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_cook), 0);
+
+  std::filesystem::remove(path);
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+// ====== ТЕСТЫ ОБНОВЛЕНИЯ ПРИ ПОВТОРНОМ ИМПОРТЕ ======
+
+TEST_F(ImportStaffAgentTest, Upsert_ReimportUpdatesInPlace)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  ScAction firstImport = CreateImportAction(*m_ctx, TEST_CSV_DATA, {SchedulingKeynodes::import_staff_upsert});
+  EXPECT_TRUE(firstImport.InitiateAndWait(5000));
+  EXPECT_TRUE(firstImport.IsFinishedSuccessfully());
+  ScAddr cook = TestUtils::FindEmployeeByName(*m_ctx, "Захаренков");
+
+  std::string const changedCsv = 
+      "profession,name,allowed_shifts\n"
+      "повар,Захаренков,N\n"
+      "официант,Лойко,M;D;N\n"
+      "администратор,Шумилов,D\n";
+  ScAction secondImport = CreateImportAction(*m_ctx, changedCsv, {SchedulingKeynodes::import_staff_upsert});
+  EXPECT_TRUE(secondImport.InitiateAndWait(5000));
+  EXPECT_TRUE(secondImport.IsFinishedSuccessfully());
+
+  // Дубликаты не созданы, ограничения заменены
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 3);
+  EXPECT_EQ(TestUtils::FindEmployeeByName(*m_ctx, "Захаренков"), cook);
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, cook), 1);
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, cook, SchedulingKeynodes::concept_night_shift));
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, Upsert_ByIdColumnRenamesAndChangesProfession)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  std::string const firstCsv = 
+      "id,profession,name,allowed_shifts\n"
+      "E-1,повар,Иванов,M\n";
+  ScAction firstImport = CreateImportAction(*m_ctx, firstCsv, {SchedulingKeynodes::import_staff_upsert});
+  EXPECT_TRUE(firstImport.InitiateAndWait(5000));
+  ScAddr employee = TestUtils::FindEmployeeByName(*m_ctx, "Иванов");
+  ASSERT_TRUE(employee.IsValid());
+
+  std::string const secondCsv = 
+      "id,profession,name,allowed_shifts\n"
+      "E-1,официант,Иванов-Петров,D\n";
+  ScAction secondImport = CreateImportAction(*m_ctx, secondCsv, {SchedulingKeynodes::import_staff_upsert});
+  EXPECT_TRUE(secondImport.InitiateAndWait(5000));
+  EXPECT_TRUE(secondImport.IsFinishedSuccessfully());
+
+  EXPECT_EQ(TestUtils::FindEmployeeByName(*m_ctx, "Иванов-Петров"), employee);
+  EXPECT_FALSE(m_ctx->CheckConnector(SchedulingKeynodes::concept_cook, employee, ScType::ConstPermPosArc));
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_waiter, employee, ScType::ConstPermPosArc));
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, employee), 1);
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, employee, SchedulingKeynodes::concept_day_shift));
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 1);
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, Upsert_IdColumnAdoptsEmployeesWithoutId)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  // Штат импортирован до появления колонки id
+  ScAction firstImport = CreateImportAction(*m_ctx, TEST_CSV_DATA);
+  EXPECT_TRUE(firstImport.InitiateAndWait(5000));
+  EXPECT_TRUE(firstImport.IsFinishedSuccessfully());
+  ScAddr cook = TestUtils::FindEmployeeByName(*m_ctx, "Захаренков");
+  ASSERT_TRUE(cook.IsValid());
+
+  std::string const csvWithIds = 
+      "id,profession,name,allowed_shifts\n"
+      "E-1,повар,Захаренков,N\n"
+      "E-2,официант,Лойко,M;D;N\n"
+      "E-3,администратор,Шумилов,D\n";
+  ScAction secondImport = CreateImportAction(*m_ctx, csvWithIds, {SchedulingKeynodes::import_staff_upsert});
+  EXPECT_TRUE(secondImport.InitiateAndWait(5000));
+  EXPECT_TRUE(secondImport.IsFinishedSuccessfully());
+
+  // Новые сотрудники не созданы: найденные по имени получили идентификаторы
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 3);
+  EXPECT_EQ(TestUtils::FindEmployeeByName(*m_ctx, "Захаренков"), cook);
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, cook, SchedulingKeynodes::concept_night_shift));
+
+  ScIterator5Ptr itId = m_ctx->CreateIterator5(
+      cook, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_employee_id);
+  ASSERT_TRUE(itId->Next());
+  std::string id;
+  m_ctx->GetLinkContent(itId->Get(2), id);
+  EXPECT_EQ(id, "E-1");
+
+  // Повторный импорт находит сотрудников уже по идентификатору
+  ScAction thirdImport = CreateImportAction(*m_ctx, csvWithIds, {SchedulingKeynodes::import_staff_upsert});
+  EXPECT_TRUE(thirdImport.InitiateAndWait(5000));
+  EXPECT_TRUE(thirdImport.IsFinishedSuccessfully());
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 3);
+
+  int idCount = 0;
+  ScIterator5Ptr itIds = m_ctx->CreateIterator5(
+      cook, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_employee_id);
+  while (itIds->Next())
+    idCount++;
+  EXPECT_EQ(idCount, 1);
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, Delta_AddUpdateRemove)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  std::string const initialCsv = 
+      "id,profession,name,allowed_shifts\n"
+      "E-1,повар,Иванов,M\n"
+      "E-2,официант,Петров,D\n"
+      "E-3,бармен,Сидоров,N\n";
+  ScAction initialImport = CreateImportAction(*m_ctx, initialCsv);
+  EXPECT_TRUE(initialImport.InitiateAndWait(5000));
+  ScAddr ivanov = TestUtils::FindEmployeeByName(*m_ctx, "Иванов");
+  ScAddr petrov = TestUtils::FindEmployeeByName(*m_ctx, "Петров");
+  ASSERT_TRUE(ivanov.IsValid());
+  ASSERT_TRUE(petrov.IsValid());
+
+  std::string const deltaCsv = 
+      "op,id,profession,name,allowed_shifts\n"
+      "update,E-1,повар,Иванов,M;D\n"
+      "remove,E-2,,,\n"
+      "add,E-4,повар,Смирнов,N\n"
+      "update,E-9,повар,Неизвестный,M\n"
+      "rename,E-3,бармен,Сидоров,N\n";
+  ScAction deltaImport = CreateImportAction(*m_ctx, deltaCsv);
+  EXPECT_TRUE(deltaImport.InitiateAndWait(5000));
+  EXPECT_TRUE(deltaImport.IsFinishedSuccessfully());
+
+  EXPECT_EQ(TestUtils::FindEmployeeByName(*m_ctx, "Иванов"), ivanov);
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, ivanov), 2);
+
+  EXPECT_FALSE(m_ctx->CheckConnector(SchedulingKeynodes::concept_employee, petrov, ScType::ConstPermPosArc));
+  EXPECT_FALSE(m_ctx->CheckConnector(SchedulingKeynodes::concept_waiter, petrov, ScType::ConstPermPosArc));
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, petrov), 0);
+
+  EXPECT_TRUE(TestUtils::FindEmployeeByName(*m_ctx, "Смирнов").IsValid());
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Неизвестный").IsValid());
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 3);
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, Delta_RemoveThenAddRestoresSameNode)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  std::string const initialCsv = 
+      "id,profession,name,allowed_shifts\n"
+      "E-1,повар,Иванов,M\n"
+      "E-2,официант,Петров,D\n";
+  ScAction initialImport = CreateImportAction(*m_ctx, initialCsv);
+  EXPECT_TRUE(initialImport.InitiateAndWait(5000));
+  ScAddr petrov = TestUtils::FindEmployeeByName(*m_ctx, "Петров");
+  ASSERT_TRUE(petrov.IsValid());
+
+  ScAction removeImport = CreateImportAction(*m_ctx, "op,id,profession,name,allowed_shifts\nremove,E-2,,,\n");
+  EXPECT_TRUE(removeImport.InitiateAndWait(5000));
+  EXPECT_TRUE(removeImport.IsFinishedSuccessfully());
+  EXPECT_FALSE(m_ctx->CheckConnector(SchedulingKeynodes::concept_employee, petrov, ScType::ConstPermPosArc));
+
+  // Сотрудник с тем же идентификатором возвращается на прежний узел, второй узел с E-2 не создаётся
+  ScAction addImport = CreateImportAction(*m_ctx, "op,id,profession,name,allowed_shifts\nadd,E-2,повар,Петров,N\n");
+  EXPECT_TRUE(addImport.InitiateAndWait(5000));
+  EXPECT_TRUE(addImport.IsFinishedSuccessfully());
+
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_employee, petrov, ScType::ConstPermPosArc));
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_cook, petrov, ScType::ConstPermPosArc));
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, petrov), 1);
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, petrov, SchedulingKeynodes::concept_night_shift));
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 2);
+
+  int nodesWithId = 0;
+  ScIterator5Ptr itId = m_ctx->CreateIterator5(
+      ScType::ConstNode, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_employee_id);
+  while (itId->Next())
+  {
+    std::string id;
+    m_ctx->GetLinkContent(itId->Get(2), id);
+    if (id == "E-2")
+      nodesWithId++;
+  }
+  EXPECT_EQ(nodesWithId, 1);
+
+  // Удаление и добавление в одном файле также сохраняют узел
+  ScAction deltaImport = CreateImportAction(
+      *m_ctx, "op,id,profession,name,allowed_shifts\nremove,E-2,,,\nadd,E-2,официант,Петров,D\n");
+  EXPECT_TRUE(deltaImport.InitiateAndWait(5000));
+  EXPECT_TRUE(deltaImport.IsFinishedSuccessfully());
+  EXPECT_EQ(TestUtils::FindEmployeeByName(*m_ctx, "Петров"), petrov);
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_waiter, petrov, ScType::ConstPermPosArc));
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 2);
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, Atomic_InvalidRowRollsBackWholeImport)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  std::string const initialCsv = 
+      "id,profession,name,allowed_shifts\n"
+      "E-1,повар,Иванов,M\n";
+  ScAction initialImport = CreateImportAction(*m_ctx, initialCsv);
+  EXPECT_TRUE(initialImport.InitiateAndWait(5000));
+  ScAddr ivanov = TestUtils::FindEmployeeByName(*m_ctx, "Иванов");
+  ASSERT_TRUE(ivanov.IsValid());
+
+  std::string const brokenCsv = 
+      "id,profession,name,allowed_shifts\n"
+      "E-1,официант,Иванов-Петров,D;N\n"
+      "E-2,повар,Смирнов,M\n"
+      "E-3,инженер,Зотов,M\n";
+  ScAction brokenImport = CreateImportAction(
+      *m_ctx, brokenCsv, {SchedulingKeynodes::import_staff_upsert, SchedulingKeynodes::import_staff_atomic});
+  EXPECT_TRUE(brokenImport.InitiateAndWait(5000));
+  EXPECT_TRUE(brokenImport.IsFinishedWithError());
+
+  EXPECT_EQ(TestUtils::FindEmployeeByName(*m_ctx, "Иванов"), ivanov);
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_cook, ivanov, ScType::ConstPermPosArc));
+  EXPECT_FALSE(m_ctx->CheckConnector(SchedulingKeynodes::concept_waiter, ivanov, ScType::ConstPermPosArc));
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, ivanov), 1);
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, ivanov, SchedulingKeynodes::concept_morning_shift));
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Смирнов").IsValid());
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 1);
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
+
+TEST_F(ImportStaffAgentTest, CodesFromKnowledgeBase)
+{
+  m_ctx->SubscribeAgent<ImportStaffAgent>();
+
+  // Новая профессия и дополнительный код смены задаются без изменения кода агента
+  auto const addCode = [this](ScAddr const & classAddr, ScAddr const & relation, std::string const & code) {
+    ScAddr link = m_ctx->GenerateLink(ScType::ConstNodeLink);
+    m_ctx->SetLinkContent(link, code);
+    ScAddr arc = m_ctx->GenerateConnector(ScType::ConstCommonArc, classAddr, link);
+    m_ctx->GenerateConnector(ScType::ConstPermPosArc, relation, arc);
+  };
+  ScAddr bartender = m_ctx->GenerateNode(ScType::ConstNodeClass);
+  addCode(bartender, SchedulingKeynodes::nrel_profession_code, "бармен");
+  addCode(SchedulingKeynodes::concept_night_shift, SchedulingKeynodes::nrel_shift_code, "night");
+
+  std::string const csv = 
+      "profession,name,allowed_shifts\n"
+      "бармен,Сидоров,night;M\n"
+      "повар,Иванов,N\n";
+  ScAction import = CreateImportAction(*m_ctx, csv);
+  EXPECT_TRUE(import.InitiateAndWait(5000));
+  EXPECT_TRUE(import.IsFinishedSuccessfully());
+
+  ScAddr sidorov = TestUtils::FindEmployeeByName(*m_ctx, "Сидоров");
+  ASSERT_TRUE(sidorov.IsValid());
+  EXPECT_TRUE(m_ctx->CheckConnector(bartender, sidorov, ScType::ConstPermPosArc));
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, sidorov, SchedulingKeynodes::concept_night_shift));
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, sidorov, SchedulingKeynodes::concept_morning_shift));
+
+  // Код по умолчанию заменяется кодом из базы знаний
+  ScAddr ivanov = TestUtils::FindEmployeeByName(*m_ctx, "Иванов");
+  ASSERT_TRUE(ivanov.IsValid());
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, ivanov), 0);
+
+  m_ctx->UnsubscribeAgent<ImportStaffAgent>();
+}
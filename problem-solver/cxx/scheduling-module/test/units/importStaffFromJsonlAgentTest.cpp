@@ -0,0 +1,100 @@
+#include <sc-memory/test/sc_test.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "agents/importStaffFromJsonlAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/TestUtils.hpp"
+
+using ImportStaffFromJsonlAgentTest = ScMemoryTest;
+
+namespace
+{
+
+ScAction CreateJsonlImportAction(ScAgentContext & ctx, std::string const & jsonl, std::vector<ScAddr> const & options = {})
+{
+  ScAddr action = ctx.GenerateNode(ScType::ConstNode);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_import_staff_from_jsonl, action);
+
+  ScAddr link = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(link, jsonl);
+  ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, action, link);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_file_content, arc);
+
+  for (ScAddr const & option : options)
+    ctx.GenerateConnector(ScType::ConstPermPosArc, action, option);
+
+  return ctx.ConvertToAction(action);
+}
+
+}  // namespace
+
+TEST_F(ImportStaffFromJsonlAgentTest, ImportsEmployees)
+{
+  m_ctx->SubscribeAgent<ImportStaffFromJsonlAgent>();
+
+  std::string const jsonl =
+      "{\"profession\": \"повар\", \"name\": \"Захаренков\", \"allowed_shifts\": [\"M\", \"D\"]}\n"
+      "{\"profession\": \"официант\", \"name\": \"Лойко\", \"allowed_shifts\": \"M;D;N\", \"forbidden_shifts\": \"N\"}\n"
+      "{\"profession\": \"инженер\", \"name\": \"Зотов\"}\n"
+      "{\"profession\": \"повар\", \"name\": \n";
+  ScAction action = CreateJsonlImportAction(*m_ctx, jsonl);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  ScAddr cook = TestUtils::FindEmployeeByName(*m_ctx, "Захаренков");
+  ASSERT_TRUE(cook.IsValid());
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_cook, cook, ScType::ConstPermPosArc));
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, cook), 2);
+
+  ScAddr waiter = TestUtils::FindEmployeeByName(*m_ctx, "Лойко");
+  ASSERT_TRUE(waiter.IsValid());
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, waiter), 3);
+
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Зотов").IsValid());
+  EXPECT_EQ(TestUtils::CountEmployeesByProfession(*m_ctx, SchedulingKeynodes::concept_employee), 2);
+
+  m_ctx->UnsubscribeAgent<ImportStaffFromJsonlAgent>();
+}
+
+TEST_F(ImportStaffFromJsonlAgentTest, OperationsUpdateExistingEmployees)
+{
+  m_ctx->SubscribeAgent<ImportStaffFromJsonlAgent>();
+
+  ScAction initialImport = CreateJsonlImportAction(
+      *m_ctx,
+      "{\"id\": 1, \"profession\": \"повар\", \"name\": \"Иванов\", \"allowed_shifts\": \"M\"}\n"
+      "{\"id\": 2, \"profession\": \"официант\", \"name\": \"Петров\", \"allowed_shifts\": \"D\"}\n");
+  EXPECT_TRUE(initialImport.InitiateAndWait(5000));
+  ScAddr ivanov = TestUtils::FindEmployeeByName(*m_ctx, "Иванов");
+  ScAddr petrov = TestUtils::FindEmployeeByName(*m_ctx, "Петров");
+  ASSERT_TRUE(ivanov.IsValid());
+  ASSERT_TRUE(petrov.IsValid());
+
+  ScAction deltaImport = CreateJsonlImportAction(
+      *m_ctx,
+      "{\"op\": \"update\", \"id\": 1, \"profession\": \"повар\", \"name\": \"Иванов\", \"allowed_shifts\": [\"M\", \"N\"]}\n"
+      "{\"op\": \"remove\", \"id\": 2}\n");
+  EXPECT_TRUE(deltaImport.InitiateAndWait(5000));
+  EXPECT_TRUE(deltaImport.IsFinishedSuccessfully());
+
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, ivanov), 2);
+  EXPECT_FALSE(m_ctx->CheckConnector(SchedulingKeynodes::concept_employee, petrov, ScType::ConstPermPosArc));
+
+  m_ctx->UnsubscribeAgent<ImportStaffFromJsonlAgent>();
+}
+
+TEST_F(ImportStaffFromJsonlAgentTest, Atomic_InvalidLineRollsBack)
+{
+  m_ctx->SubscribeAgent<ImportStaffFromJsonlAgent>();
+
+  ScAction action = CreateJsonlImportAction(
+      *m_ctx,
+      "{\"profession\": \"повар\", \"name\": \"Иванов\"}\n"
+      "{\"profession\": \"повар\", \"name\": \"Петров\"\n",
+      {SchedulingKeynodes::import_staff_atomic});
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedWithError());
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Иванов").IsValid());
+
+  m_ctx->UnsubscribeAgent<ImportStaffFromJsonlAgent>();
+}
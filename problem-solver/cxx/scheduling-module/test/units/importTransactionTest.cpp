@@ -0,0 +1,112 @@
+#include <sc-memory/test/sc_test.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/importTransaction.hpp"
+
+#include <new>
+
+using ImportTransactionTest = ScMemoryTest;
+
+namespace
+{
+
+ScAddr GenerateRelationArc(ScMemoryContext & ctx, ScAddr const & source, ScAddr const & target, ScAddr const & relation)
+{
+  ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, source, target);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, relation, arc);
+  return arc;
+}
+
+}  // namespace
+
+TEST_F(ImportTransactionTest, Commit_KeepsChanges)
+{
+  ImportTransaction transaction(*m_ctx);
+  ScAddr employee = transaction.GenerateNode(ScType::ConstNode);
+  transaction.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_employee, employee);
+  EXPECT_EQ(transaction.GetChangeCount(), 2u);
+
+  transaction.Commit();
+  EXPECT_EQ(transaction.GetChangeCount(), 0u);
+  EXPECT_EQ(transaction.Rollback(), 0u);
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_employee, employee, ScType::ConstPermPosArc));
+}
+
+TEST_F(ImportTransactionTest, Rollback_ErasesCreatedElements)
+{
+  ImportTransaction transaction(*m_ctx);
+  ScAddr employee = transaction.GenerateNode(ScType::ConstNode);
+  ScAddr name = transaction.GenerateLink(ScType::ConstNodeLink);
+  ScAddr arc = transaction.GenerateConnector(ScType::ConstCommonArc, employee, name);
+
+  EXPECT_EQ(transaction.Rollback(), 3u);
+  EXPECT_FALSE(m_ctx->IsElement(employee));
+  EXPECT_FALSE(m_ctx->IsElement(name));
+  EXPECT_FALSE(m_ctx->IsElement(arc));
+}
+
+TEST_F(ImportTransactionTest, Rollback_RestoresErasedArcsAndContent)
+{
+  ScAddr employee = m_ctx->GenerateNode(ScType::ConstNode);
+  ScAddr name = m_ctx->GenerateLink(ScType::ConstNodeLink);
+  m_ctx->SetLinkContent(name, "Иванов");
+  ScAddr shiftArc = GenerateRelationArc(
+      *m_ctx, employee, SchedulingKeynodes::concept_morning_shift, SchedulingKeynodes::nrel_allowed_shift);
+
+  ImportTransaction transaction(*m_ctx);
+  transaction.SetLinkContent(name, "Петров");
+  transaction.EraseConnector(shiftArc);
+  GenerateRelationArc(*m_ctx, employee, SchedulingKeynodes::concept_day_shift, SchedulingKeynodes::nrel_can_not_work);
+  EXPECT_FALSE(m_ctx->IsElement(shiftArc));
+
+  transaction.Rollback();
+
+  std::string content;
+  m_ctx->GetLinkContent(name, content);
+  EXPECT_EQ(content, "Иванов");
+
+  ScIterator5Ptr it = m_ctx->CreateIterator5(
+      employee, ScType::ConstCommonArc, SchedulingKeynodes::concept_morning_shift, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_allowed_shift);
+  EXPECT_TRUE(it->Next());
+}
+
+TEST_F(ImportTransactionTest, Rollback_ArcCreatedAndErasedInTransaction)
+{
+  ScAddr employee = m_ctx->GenerateNode(ScType::ConstNode);
+
+  ImportTransaction transaction(*m_ctx);
+  ScAddr arc = transaction.GenerateConnector(ScType::ConstCommonArc, employee, SchedulingKeynodes::concept_night_shift);
+  transaction.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_allowed_shift, arc);
+  transaction.EraseConnector(arc);
+
+  transaction.Rollback();
+
+  ScIterator3Ptr it = m_ctx->CreateIterator3(employee, ScType::ConstCommonArc, SchedulingKeynodes::concept_night_shift);
+  EXPECT_FALSE(it->Next());
+}
+
+TEST_F(ImportTransactionTest, Guard_RollsBackUncommittedOnException)
+{
+  ImportTransaction transaction(*m_ctx);
+  ScAddr employee;
+  try
+  {
+    ImportTransaction::Guard const guard(transaction);
+    employee = transaction.GenerateNode(ScType::ConstNode);
+    throw std::bad_alloc();
+  }
+  catch (std::bad_alloc const &)
+  {
+  }
+  EXPECT_FALSE(m_ctx->IsElement(employee));
+  EXPECT_EQ(transaction.GetChangeCount(), 0u);
+
+  {
+    ImportTransaction::Guard const guard(transaction);
+    employee = transaction.GenerateNode(ScType::ConstNode);
+    transaction.Commit();
+  }
+  EXPECT_TRUE(m_ctx->IsElement(employee));
+}
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include "utils/inFlightRegistry.hpp"
+
+#include <thread>
+#include <vector>
+
+TEST(InFlightRegistryTest, DuplicateRequestsShareResult)
+{
+  InFlightRegistry<int> registry;
+
+  auto owner = registry.Acquire("input");
+  ASSERT_TRUE(owner.isOwner);
+
+  std::vector<std::thread> waiters;
+  std::vector<int> results(4, 0);
+  for (size_t i = 0; i < results.size(); ++i)
+  {
+    auto ticket = registry.Acquire("input");
+    EXPECT_FALSE(ticket.isOwner);
+    waiters.emplace_back([ticket, &results, i] { results[i] = ticket.result.get(); });
+  }
+
+  // Другой ключ — отдельное построение
+  EXPECT_TRUE(registry.Acquire("other").isOwner);
+
+  registry.Complete("input", 42);
+  for (std::thread & waiter : waiters)
+    waiter.join();
+
+  EXPECT_EQ(results, std::vector<int>(4, 42));
+  EXPECT_EQ(owner.result.get(), 42);
+  EXPECT_EQ(registry.GetSize(), 1u);
+}
+
+TEST(InFlightRegistryTest, CompletedKeyStartsNewBuild)
+{
+  InFlightRegistry<int> registry;
+
+  ASSERT_TRUE(registry.Acquire("input").isOwner);
+  registry.Complete("input", 1);
+
+  auto ticket = registry.Acquire("input");
+  EXPECT_TRUE(ticket.isOwner);
+  registry.Complete("input", 2);
+  EXPECT_EQ(ticket.result.get(), 2);
+  EXPECT_EQ(registry.GetSize(), 0u);
+}
+
+TEST(InFlightRegistryTest, ContinuationReceivesOwnerResult)
+{
+  InFlightRegistry<int> registry;
+
+  ASSERT_TRUE(registry.Acquire("input").isOwner);
+  auto ticket = registry.Acquire("input");
+  ASSERT_FALSE(ticket.isOwner);
+
+  // Присоединившийся запрос не ждёт: результат передаётся ему при завершении построения
+  std::vector<int> results;
+  EXPECT_TRUE(registry.AddContinuation("input", [&results](int value) { results.push_back(value); }));
+  EXPECT_TRUE(results.empty());
+
+  registry.Complete("input", 7);
+  EXPECT_EQ(results, std::vector<int>{7});
+  EXPECT_EQ(ticket.result.get(), 7);
+
+  // Построение уже завершилось — продолжение не добавляется
+  EXPECT_FALSE(registry.AddContinuation("input", [&results](int value) { results.push_back(value); }));
+  EXPECT_EQ(results.size(), 1u);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "utils/mappedFile.hpp"
+
+#include <filesystem>
+#include <fstream>
+
+namespace
+{
+
+std::string WriteTempFile(std::string const & name, std::string const & content)
+{
+  std::string const path = (std::filesystem::temp_directory_path() / name).string();
+  std::ofstream(path, std::ios::binary) << content;
+  return path;
+}
+
+}  // namespace
+
+TEST(MappedFileTest, Open_MapsFileContent)
+{
+  std::string const content = "profession,name\nповар,Иванов\n";
+  std::string const path = WriteTempFile("mapped_file_test.csv", content);
+
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_TRUE(file.IsOpen());
+  EXPECT_EQ(file.GetContent(), content);
+
+  // Отображение переходит к новому владельцу
+  MappedFile moved = std::move(file);
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_EQ(moved.GetContent(), content);
+
+  moved.Close();
+  EXPECT_FALSE(moved.IsOpen());
+  EXPECT_TRUE(moved.GetContent().empty());
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, Open_EmptyFile)
+{
+  std::string const path = WriteTempFile("mapped_file_empty_test.csv", "");
+
+  MappedFile file;
+  ASSERT_TRUE(file.Open(path));
+  EXPECT_TRUE(file.GetContent().empty());
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, Open_MissingFileOrDirectory)
+{
+  MappedFile file;
+  EXPECT_FALSE(file.Open("/nonexistent/staff.csv"));
+  EXPECT_FALSE(file.IsOpen());
+  EXPECT_FALSE(file.GetError().empty());
+
+  EXPECT_FALSE(file.Open(std::filesystem::temp_directory_path().string()));
+  EXPECT_FALSE(file.GetError().empty());
+}
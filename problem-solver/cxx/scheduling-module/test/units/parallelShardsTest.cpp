@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+
+#include "utils/parallelShards.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(ParallelShardsTest, RunsEveryShardOnItsOwnThread)
+{
+  std::mutex mutex;
+  std::set<std::thread::id> threadIds;
+  std::vector<int> visited(4, 0);
+
+  RunShards(visited.size(), [&](size_t shard) {
+    visited[shard]++;
+    std::lock_guard<std::mutex> lock(mutex);
+    threadIds.insert(std::this_thread::get_id());
+  });
+
+  EXPECT_EQ(visited, std::vector<int>(4, 1));
+  EXPECT_EQ(threadIds.size(), 4u);
+  EXPECT_EQ(threadIds.count(std::this_thread::get_id()), 1u);
+}
+
+TEST(ParallelShardsTest, PropagatesErrorAfterAllShardsFinish)
+{
+  std::atomic<int> finished{0};
+
+  EXPECT_THROW(
+      RunShards(
+          3,
+          [&finished](size_t shard) {
+            if (shard == 2)
+              throw std::runtime_error("write failed");
+            ++finished;
+          }),
+      std::runtime_error);
+  EXPECT_EQ(finished.load(), 2);
+
+  RunShards(0, [](size_t) { FAIL(); });
+}
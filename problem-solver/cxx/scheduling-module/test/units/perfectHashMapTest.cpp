@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "utils/perfectHashMap.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(PerfectHashMapTest, FindsEveryKey)
+{
+  std::vector<std::pair<std::string, int>> entries;
+  for (int i = 0; i < 500; ++i)
+    entries.emplace_back("code-" + std::to_string(i), i);
+
+  PerfectHashMap<int> const map(entries);
+  EXPECT_EQ(map.Size(), entries.size());
+  for (auto const & [key, value] : entries)
+  {
+    int const * found = map.Find(key);
+    ASSERT_NE(found, nullptr) << key;
+    EXPECT_EQ(*found, value);
+  }
+}
+
+TEST(PerfectHashMapTest, MissingKeys)
+{
+  PerfectHashMap<int> const map({{"повар", 1}, {"официант", 2}, {"M", 3}});
+  EXPECT_EQ(*map.Find("официант"), 2);
+  EXPECT_EQ(map.Find("бармен"), nullptr);
+  EXPECT_EQ(map.Find(""), nullptr);
+  EXPECT_EQ(map.Find("повар "), nullptr);
+
+  PerfectHashMap<int> const empty;
+  EXPECT_EQ(empty.Find("повар"), nullptr);
+  EXPECT_EQ(empty.begin(), empty.end());
+}
+
+TEST(PerfectHashMapTest, IteratesAllEntries)
+{
+  PerfectHashMap<int> const map({{"M", 1}, {"D", 2}, {"N", 4}});
+  int sum = 0;
+  for (auto const & [key, value] : map)
+    sum += value;
+  EXPECT_EQ(sum, 7);
+}
+
+TEST(PerfectHashMapTest, DuplicateKeyThrows)
+{
+  EXPECT_THROW(PerfectHashMap<int>({{"M", 1}, {"M", 2}}), std::invalid_argument);
+}
@@ -2,94 +2,32 @@
 #include <sc-memory/sc_memory.hpp>
 
 #include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
 
 #include "agents/scheduleBuilderAgent.hpp"
 #include "keynodes/scheduling-keynodes.hpp"
 #include "utils/TestUtils.hpp"
+#include "utils/buildWorkerPool.hpp"
+#include "utils/scheduleEncoding.hpp"
 
 using ScheduleBuilderAgentTest = ScMemoryTest;
 
 namespace
 {
 
-// Создаёт тестового сотрудника
-ScAddr CreateEmployee(
-    ScAgentContext & ctx,
-    std::string const & name,
-    ScAddr const & profession,
-    std::vector<ScAddr> const & allowedShifts = {},
-    std::vector<ScAddr> const & forbiddenShifts = {})
-{
-  ScAddr emp = ctx.GenerateNode(ScType::ConstNode);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, profession, emp);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_employee, emp);
-  
-  // Имя
-  ScAddr nameLink = ctx.GenerateLink(ScType::ConstNodeLink);
-  ctx.SetLinkContent(nameLink, name);
-  ScAddr nameArc = ctx.GenerateConnector(ScType::ConstCommonArc, emp, nameLink);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, ScKeynodes::nrel_main_idtf, nameArc);
-  
-  // Разрешённые смены
-  for (auto const & shift : allowedShifts)
-  {
-    ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, emp, shift);
-    ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_allowed_shift, arc);
-  }
-  
-  // Запрещённые смены
-  for (auto const & shift : forbiddenShifts)
-  {
-    ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, emp, shift);
-    ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_can_not_work, arc);
-  }
-  
-  return emp;
-}
+using TestUtils::CreateBuildAction;
+using TestUtils::CreateEmployee;
+using TestUtils::CreateShiftRequirements;
 
-// Создаёт требования к составу смены
-ScAddr CreateShiftRequirements(
-    ScAgentContext & ctx,
-    int cooks,
-    int waiters,
-    int cleaners,
-    int admins,
-    int maxShiftsPerWeek)
+// Задаёт, сколько последних расписаний хранить для требований
+void SetMaxStoredSchedules(ScAgentContext & ctx, ScAddr const & requirements, int maxStoredSchedules)
 {
-  ScAddr reqs = ctx.GenerateNode(ScType::ConstNode);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_shift_requirements, reqs);
-  
-  // Количество поваров
-  ScAddr cookCount = ctx.GenerateLink(ScType::ConstNodeLink);
-  ctx.SetLinkContent(cookCount, std::to_string(cooks));
-  ScAddr arcCook = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_cook, cookCount);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcCook);
-  
-  // Количество официантов
-  ScAddr waiterCount = ctx.GenerateLink(ScType::ConstNodeLink);
-  ctx.SetLinkContent(waiterCount, std::to_string(waiters));
-  ScAddr arcWaiter = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_waiter, waiterCount);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcWaiter);
-  
-  // Количество уборщиков
-  ScAddr cleanerCount = ctx.GenerateLink(ScType::ConstNodeLink);
-  ctx.SetLinkContent(cleanerCount, std::to_string(cleaners));
-  ScAddr arcCleaner = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_cleaner, cleanerCount);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcCleaner);
-  
-  // Количество администраторов
-  ScAddr adminCount = ctx.GenerateLink(ScType::ConstNodeLink);
-  ctx.SetLinkContent(adminCount, std::to_string(admins));
-  ScAddr arcAdmin = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_admin, adminCount);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcAdmin);
-  
-  // Максимум смен в неделю
-  ScAddr maxLink = ctx.GenerateLink(ScType::ConstNodeLink);
-  ctx.SetLinkContent(maxLink, std::to_string(maxShiftsPerWeek));
-  ScAddr arcMax = ctx.GenerateConnector(ScType::ConstCommonArc, reqs, maxLink);
-  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_max_shifts_per_week, arcMax);
-  
-  return reqs;
+  ScAddr storedLink = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(storedLink, std::to_string(maxStoredSchedules));
+  ScAddr arcStored = ctx.GenerateConnector(ScType::ConstCommonArc, requirements, storedLink);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_max_stored_schedules, arcStored);
 }
 
 // Создаёт минимальный штат для тестирования
@@ -156,6 +94,16 @@ int CountShiftSlots(ScAgentContext & ctx)
   return count;
 }
 
+// Подсчитывает количество элементов класса
+int CountClassElements(ScAgentContext & ctx, ScAddr const & classAddr)
+{
+  int count = 0;
+  ScIterator3Ptr it = ctx.CreateIterator3(classAddr, ScType::ConstPermPosArc, ScType::Unknown);
+  while (it->Next())
+    count++;
+  return count;
+}
+
 }  // namespace
 
 // ====== БАЗОВЫЕ ТЕСТЫ ======
@@ -272,6 +220,121 @@ TEST_F(ScheduleBuilderAgentTest, BipartiteGraph_HasLeftAndRightParts)
   ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
 }
 
+TEST_F(ScheduleBuilderAgentTest, BipartiteGraph_PersistenceNone)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::graph_persistence_none});
+  EXPECT_TRUE(scAction.InitiateAndWait(10000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  
+  // Граф и слоты не сохраняются, назначения создаются как обычно
+  EXPECT_FALSE(BipartiteGraphExists(ctx));
+  EXPECT_EQ(CountShiftSlots(ctx), 0);
+  EXPECT_GT(CountAssignments(ctx), 0);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, BipartiteGraph_PersistenceMatchedEdges)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  
+  // Повар может работать только утром — дневные и ночные слоты поваров останутся пустыми
+  CreateEmployee(ctx, "ПоварУтро", SchedulingKeynodes::concept_cook,
+      {SchedulingKeynodes::concept_morning_shift}, {});
+  CreateEmployee(ctx, "Официант1", SchedulingKeynodes::concept_waiter);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 0, 0, 7);
+  ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::graph_persistence_matched_edges});
+  EXPECT_TRUE(scAction.InitiateAndWait(10000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  
+  // В правой доле только занятые слоты: по одному на каждое назначение
+  EXPECT_TRUE(BipartiteGraphExists(ctx));
+  EXPECT_EQ(CountShiftSlots(ctx), CountAssignments(ctx));
+  EXPECT_LT(CountShiftSlots(ctx), 42);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, BipartiteGraph_SlotNodesReusedAcrossBuilds)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  ScAction firstAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_rebuild_forced});
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  EXPECT_TRUE(firstAction.IsFinishedSuccessfully());
+  EXPECT_EQ(CountShiftSlots(ctx), 84);
+  
+  // Повторное построение использует уже существующие узлы слотов
+  ScAction secondAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_rebuild_forced});
+  EXPECT_TRUE(secondAction.InitiateAndWait(10000));
+  EXPECT_TRUE(secondAction.IsFinishedSuccessfully());
+  EXPECT_EQ(CountShiftSlots(ctx), 84);
+  
+  int graphCount = 0;
+  ScIterator3Ptr itGraph = ctx.CreateIterator3(
+      SchedulingKeynodes::concept_bipartite_graph, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (itGraph->Next())
+    graphCount++;
+  EXPECT_EQ(graphCount, 2);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+// ====== ТЕСТЫ КОМПАКТНОГО ПРЕДСТАВЛЕНИЯ ======
+
+TEST_F(ScheduleBuilderAgentTest, Encoding_BinaryLinkCreated)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_encoding_binary});
+  EXPECT_TRUE(scAction.InitiateAndWait(10000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  
+  ScAddr schedule = scAction.GetResult();
+  ScIterator5Ptr itEncoding = ctx.CreateIterator5(
+      schedule, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_schedule_encoding);
+  ASSERT_TRUE(itEncoding->Next());
+  
+  std::string content;
+  ASSERT_TRUE(ctx.GetLinkContent(itEncoding->Get(2), content));
+  
+  EncodedSchedule encoded;
+  ASSERT_TRUE(ScheduleEncoding::Decode(content, encoded));
+  EXPECT_EQ(encoded.daysCount, 7);
+  EXPECT_EQ(encoded.shiftsCount, 3);
+  EXPECT_EQ(encoded.employeeIds.size(), 12u);
+  
+  // Количество установленных битов совпадает с количеством назначений
+  int encodedShifts = 0;
+  for (uint32_t mask : encoded.shiftMasks)
+  {
+    for (; mask != 0; mask &= mask - 1)
+      encodedShifts++;
+  }
+  EXPECT_EQ(encodedShifts, CountAssignments(ctx));
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
 // ====== ТЕСТЫ ПАРОСОЧЕТАНИЯ ======
 
 TEST_F(ScheduleBuilderAgentTest, Matching_RespectsMaxShiftsPerWeek)
@@ -496,6 +559,38 @@ TEST_F(ScheduleBuilderAgentTest, Requirements_ZeroProfession)
   ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
 }
 
+TEST_F(ScheduleBuilderAgentTest, Requirements_ProfessionFromKnowledgeBase)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  
+  // Профессия добавлена в базу знаний: код и количество на смену, без изменения кода агента
+  ScAddr bartender = ctx.GenerateNode(ScType::ConstNodeClass);
+  ScAddr codeLink = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(codeLink, "бармен");
+  ScAddr arcCode = ctx.GenerateConnector(ScType::ConstCommonArc, bartender, codeLink);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_profession_code, arcCode);
+  ScAddr countLink = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(countLink, "1");
+  ScAddr arcCount = ctx.GenerateConnector(ScType::ConstCommonArc, bartender, countLink);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcCount);
+  
+  CreateEmployee(ctx, "Повар1", SchedulingKeynodes::concept_cook);
+  CreateEmployee(ctx, "Бармен1", bartender);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 0, 0, 0, 7);
+  ScAction scAction = CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(scAction.InitiateAndWait(10000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  
+  // Слотов: 7 дней * 3 смены * 2 профессии (повар и бармен) = 42
+  EXPECT_EQ(CountShiftSlots(ctx), 42);
+  EXPECT_EQ(TestUtils::GetEmployeeWorkloadByName(ctx, "Бармен1"), 7);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
 // ====== ТЕСТЫ ГРАНИЧНЫХ СЛУЧАЕВ ======
 
 TEST_F(ScheduleBuilderAgentTest, Edge_OneEmployeePerProfession)
@@ -583,3 +678,431 @@ TEST_F(ScheduleBuilderAgentTest, Edge_NoRequirementsProvided)
   
   ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
 }
+
+// ====== ТЕСТЫ ИСТОРИИ РАСПИСАНИЙ ======
+
+TEST_F(ScheduleBuilderAgentTest, History_SupersededSchedulesErased)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  SetMaxStoredSchedules(ctx, requirements, 1);
+  
+  ScAction firstAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_rebuild_forced});
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  EXPECT_TRUE(firstAction.IsFinishedSuccessfully());
+  int assignmentsPerBuild = CountAssignments(ctx);
+  ScAddr firstSchedule = firstAction.GetResult();
+  
+  for (int i = 0; i < 2; ++i)
+  {
+    ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_rebuild_forced});
+    EXPECT_TRUE(scAction.InitiateAndWait(10000));
+    EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  }
+  
+  // Остаётся только последнее расписание со своими назначениями и графом
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 1);
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_bipartite_graph), 1);
+  EXPECT_EQ(CountAssignments(ctx), assignmentsPerBuild);
+  EXPECT_EQ(CountShiftSlots(ctx), 84);
+  EXPECT_FALSE(ctx.IsElement(firstSchedule));
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, History_KeptWithoutRetentionPolicy)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  for (int i = 0; i < 2; ++i)
+  {
+    ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_rebuild_forced});
+    EXPECT_TRUE(scAction.InitiateAndWait(10000));
+    EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  }
+  
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 2);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, History_DiffPersistenceReusesAssignments)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  ScAction firstAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_persistence_diff});
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  EXPECT_TRUE(firstAction.IsFinishedSuccessfully());
+  int assignmentsPerBuild = CountAssignments(ctx);
+  
+  // Первое построение сохраняется целиком — сравнивать не с чем
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule_diff), 0);
+  
+  // Штат не менялся: новых назначений не создаётся, все берутся из предыдущего расписания
+  ScAction secondAction = CreateBuildAction(
+      ctx, requirements, {SchedulingKeynodes::schedule_persistence_diff, SchedulingKeynodes::schedule_rebuild_forced});
+  EXPECT_TRUE(secondAction.InitiateAndWait(10000));
+  EXPECT_TRUE(secondAction.IsFinishedSuccessfully());
+  EXPECT_EQ(CountAssignments(ctx), assignmentsPerBuild);
+  
+  ScAddr secondSchedule = secondAction.GetResult();
+  ScIterator5Ptr itDiff = ctx.CreateIterator5(
+      secondSchedule, ScType::ConstCommonArc, ScType::ConstNodeStructure, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_schedule_diff);
+  ASSERT_TRUE(itDiff->Next());
+  ScAddr diff = itDiff->Get(2);
+  
+  ScIterator5Ptr itAdded = ctx.CreateIterator5(
+      diff, ScType::ConstPermPosArc, ScType::ConstNode, ScType::ConstPermPosArc,
+      SchedulingKeynodes::rrel_added_assignment);
+  EXPECT_FALSE(itAdded->Next());
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, History_DiffPersistenceWithRetention)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateEmployee(ctx, "Повар1", SchedulingKeynodes::concept_cook);
+  CreateEmployee(ctx, "Официант1", SchedulingKeynodes::concept_waiter);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 0, 0, 7);
+  SetMaxStoredSchedules(ctx, requirements, 1);
+  
+  ScAction firstAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_persistence_diff});
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  int assignmentsPerBuild = CountAssignments(ctx);
+  
+  // Новый сотрудник меняет часть назначений; общие назначения не удаляются вместе со старым расписанием
+  CreateEmployee(ctx, "Повар2", SchedulingKeynodes::concept_cook);
+  ScAction secondAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_persistence_diff});
+  EXPECT_TRUE(secondAction.InitiateAndWait(10000));
+  EXPECT_TRUE(secondAction.IsFinishedSuccessfully());
+  
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 1);
+  
+  int assignmentsInSchedule = 0;
+  ScAddr schedule = secondAction.GetResult();
+  ScIterator3Ptr itAssignment = ctx.CreateIterator3(schedule, ScType::ConstPermPosArc, ScType::ConstNode);
+  while (itAssignment->Next())
+  {
+    if (ctx.CheckConnector(
+            SchedulingKeynodes::concept_shift_assignment, itAssignment->Get(2), ScType::ConstPermPosArc))
+      assignmentsInSchedule++;
+  }
+  EXPECT_EQ(assignmentsInSchedule, CountAssignments(ctx));
+  EXPECT_GE(assignmentsInSchedule, assignmentsPerBuild);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+// ====== ТЕСТЫ ПОВТОРНОГО ИСПОЛЬЗОВАНИЯ РАСПИСАНИЯ ======
+
+TEST_F(ScheduleBuilderAgentTest, Fingerprint_UnchangedInputReturnsStoredSchedule)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  ScAction firstAction = CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  EXPECT_TRUE(firstAction.IsFinishedSuccessfully());
+  int assignmentsPerBuild = CountAssignments(ctx);
+  
+  // Штат и требования не менялись: расписание не строится заново
+  ScAction secondAction = CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(secondAction.InitiateAndWait(10000));
+  EXPECT_TRUE(secondAction.IsFinishedSuccessfully());
+  
+  EXPECT_EQ(secondAction.GetResult(), firstAction.GetResult());
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 1);
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_bipartite_graph), 1);
+  EXPECT_EQ(CountAssignments(ctx), assignmentsPerBuild);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, Fingerprint_ChangedInputRebuilds)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  ScAction firstAction = CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  EXPECT_TRUE(firstAction.IsFinishedSuccessfully());
+  
+  // Другие параметры построения дают другой отпечаток
+  ScAction encodedAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_encoding_binary});
+  EXPECT_TRUE(encodedAction.InitiateAndWait(10000));
+  EXPECT_TRUE(encodedAction.IsFinishedSuccessfully());
+  EXPECT_NE(encodedAction.GetResult(), firstAction.GetResult());
+  
+  // Новый сотрудник меняет штат
+  CreateEmployee(ctx, "Повар5", SchedulingKeynodes::concept_cook);
+  ScAction secondAction = CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(secondAction.InitiateAndWait(10000));
+  EXPECT_TRUE(secondAction.IsFinishedSuccessfully());
+  EXPECT_NE(secondAction.GetResult(), firstAction.GetResult());
+  
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 3);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, Fingerprint_OtherRequirementsNodeRebuilds)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr firstRequirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  ScAction firstAction = CreateBuildAction(ctx, firstRequirements);
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  EXPECT_TRUE(firstAction.IsFinishedSuccessfully());
+  
+  // Те же значения в другом узле требований: расписание строится для его истории
+  ScAddr secondRequirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  ScAction secondAction = CreateBuildAction(ctx, secondRequirements);
+  EXPECT_TRUE(secondAction.InitiateAndWait(10000));
+  EXPECT_TRUE(secondAction.IsFinishedSuccessfully());
+  EXPECT_NE(secondAction.GetResult(), firstAction.GetResult());
+  
+  ScIterator5Ptr itHistory = ctx.CreateIterator5(
+      secondAction.GetResult(), ScType::ConstCommonArc, secondRequirements, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_schedule_requirements);
+  EXPECT_TRUE(itHistory->Next());
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 2);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+// ====== ТЕСТЫ ПУБЛИКАЦИИ РАСПИСАНИЯ ======
+
+TEST_F(ScheduleBuilderAgentTest, Publish_CurrentScheduleSwitched)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  ScAction firstAction = CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(firstAction.InitiateAndWait(10000));
+  EXPECT_TRUE(firstAction.IsFinishedSuccessfully());
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::current_schedule), 1);
+  EXPECT_TRUE(ctx.CheckConnector(
+      SchedulingKeynodes::current_schedule, firstAction.GetResult(), ScType::ConstPermPosArc));
+  
+  ScAction secondAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_rebuild_forced});
+  EXPECT_TRUE(secondAction.InitiateAndWait(10000));
+  EXPECT_TRUE(secondAction.IsFinishedSuccessfully());
+  
+  // Текущим становится новое расписание, старое остаётся в истории
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::current_schedule), 1);
+  EXPECT_TRUE(ctx.CheckConnector(
+      SchedulingKeynodes::current_schedule, secondAction.GetResult(), ScType::ConstPermPosArc));
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 2);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+// ====== ТЕСТЫ АСИНХРОННОГО ПОСТРОЕНИЯ ======
+
+TEST_F(ScheduleBuilderAgentTest, Async_JobFinishesWithSchedule)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  // Действие принимается сразу, результат — задание построения
+  ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_build_async});
+  EXPECT_TRUE(scAction.InitiateAndWait(10000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  
+  ScIterator3Ptr itJob = ctx.CreateIterator3(scAction.GetResult(), ScType::ConstPermPosArc, ScType::ConstNode);
+  ASSERT_TRUE(itJob->Next());
+  ScAddr jobAddr = itJob->Get(2);
+  EXPECT_TRUE(ctx.CheckConnector(SchedulingKeynodes::action_schedule_build_job, jobAddr, ScType::ConstPermPosArc));
+  
+  ScAction job = ctx.ConvertToAction(jobAddr);
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!job.IsFinished() && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  
+  EXPECT_TRUE(job.IsFinishedSuccessfully());
+  ScAddr schedule = job.GetResult();
+  EXPECT_TRUE(ctx.CheckConnector(SchedulingKeynodes::concept_schedule, schedule, ScType::ConstPermPosArc));
+  EXPECT_GT(CountAssignments(ctx), 0);
+  
+  BuildWorkerPool::GetInstance().Shutdown();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, Async_FailedBuildFinishesJobWithError)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  
+  // Штата нет: построение в потоке пула завершается ошибкой
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_build_async});
+  EXPECT_TRUE(scAction.InitiateAndWait(10000));
+  EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  
+  ScIterator3Ptr itJob = ctx.CreateIterator3(scAction.GetResult(), ScType::ConstPermPosArc, ScType::ConstNode);
+  ASSERT_TRUE(itJob->Next());
+  ScAction job = ctx.ConvertToAction(itJob->Get(2));
+  
+  // Задание не должно оставаться незавершённым
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!job.IsFinished() && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  
+  EXPECT_TRUE(job.IsFinished());
+  EXPECT_TRUE(job.IsFinishedWithError());
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 0);
+  
+  BuildWorkerPool::GetInstance().Shutdown();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+// ====== ТЕСТЫ ОБЪЕДИНЕНИЯ ОДИНАКОВЫХ ЗАПРОСОВ ======
+
+TEST_F(ScheduleBuilderAgentTest, Coalescing_ConcurrentDuplicateRequestsShareResult)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  std::vector<ScAction> actions;
+  for (int i = 0; i < 3; ++i)
+    actions.push_back(CreateBuildAction(ctx, requirements));
+  for (ScAction & scAction : actions)
+    scAction.Initiate();
+  
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+  for (ScAction & scAction : actions)
+  {
+    while (!scAction.IsFinished() && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(scAction.IsFinishedSuccessfully());
+  }
+  
+  // Одновременные запросы дожидаются первого построения, последующие получают сохранённое расписание
+  for (ScAction & scAction : actions)
+    EXPECT_EQ(scAction.GetResult(), actions.front().GetResult());
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 1);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleBuilderAgentTest, Coalescing_AsyncDuplicateJobsShareResult)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  std::vector<ScAction> jobs;
+  for (int i = 0; i < 3; ++i)
+  {
+    ScAction scAction = CreateBuildAction(ctx, requirements, {SchedulingKeynodes::schedule_build_async});
+    EXPECT_TRUE(scAction.InitiateAndWait(10000));
+    ScIterator3Ptr itJob = ctx.CreateIterator3(scAction.GetResult(), ScType::ConstPermPosArc, ScType::ConstNode);
+    ASSERT_TRUE(itJob->Next());
+    jobs.push_back(ctx.ConvertToAction(itJob->Get(2)));
+  }
+  
+  // Присоединённые задания завершаются вместе с построением, к которому присоединились
+  auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds(20);
+  for (ScAction & job : jobs)
+  {
+    while (!job.IsFinished() && std::chrono::steady_clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(job.IsFinishedSuccessfully());
+  }
+  
+  for (ScAction & job : jobs)
+    EXPECT_EQ(job.GetResult(), jobs.front().GetResult());
+  EXPECT_EQ(CountClassElements(ctx, SchedulingKeynodes::concept_schedule), 1);
+  
+  BuildWorkerPool::GetInstance().Shutdown();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+// ====== ТЕСТЫ ПАРАЛЛЕЛЬНОЙ ЗАПИСИ ======
+
+TEST_F(ScheduleBuilderAgentTest, ParallelPersistence_SameScheduleAsSingleWriter)
+{
+  ScAgentContext & ctx = *m_ctx;
+  
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  CreateMinimalStaff(ctx);
+  
+  ScAddr requirements = CreateShiftRequirements(ctx, 1, 1, 1, 1, 5);
+  
+  ScAction singleAction = CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(singleAction.InitiateAndWait(10000));
+  EXPECT_TRUE(singleAction.IsFinishedSuccessfully());
+  int assignmentsPerBuild = CountAssignments(ctx);
+  
+  ScAction parallelAction = CreateBuildAction(
+      ctx, requirements, {SchedulingKeynodes::schedule_parallel_persistence, SchedulingKeynodes::schedule_rebuild_forced});
+  EXPECT_TRUE(parallelAction.InitiateAndWait(10000));
+  EXPECT_TRUE(parallelAction.IsFinishedSuccessfully());
+  
+  // Каждое назначение записано ровно один раз и входит в расписание
+  EXPECT_EQ(CountAssignments(ctx), assignmentsPerBuild * 2);
+  
+  int assignmentsInSchedule = 0;
+  int workloadsInSchedule = 0;
+  ScAddr schedule = parallelAction.GetResult();
+  ScIterator3Ptr it = ctx.CreateIterator3(schedule, ScType::ConstPermPosArc, ScType::Unknown);
+  while (it->Next())
+  {
+    ScAddr element = it->Get(2);
+    if (ctx.CheckConnector(SchedulingKeynodes::concept_shift_assignment, element, ScType::ConstPermPosArc))
+      assignmentsInSchedule++;
+    else if (ctx.CheckConnector(SchedulingKeynodes::nrel_workload, element, ScType::ConstPermPosArc))
+      workloadsInSchedule++;
+  }
+  EXPECT_EQ(assignmentsInSchedule, assignmentsPerBuild);
+  EXPECT_EQ(workloadsInSchedule, 12);
+  
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
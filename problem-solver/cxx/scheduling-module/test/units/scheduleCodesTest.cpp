@@ -0,0 +1,82 @@
+#include <sc-memory/test/sc_test.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/scheduleCodes.hpp"
+
+#include <string>
+#include <vector>
+
+using ScheduleCodesTest = ScMemoryTest;
+
+namespace
+{
+
+void AddProfessionCode(ScMemoryContext & ctx, ScAddr const & classAddr, std::string const & code)
+{
+  ScAddr link = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(link, code);
+  ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, classAddr, link);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_profession_code, arc);
+}
+
+}  // namespace
+
+TEST_F(ScheduleCodesTest, CanonicalCodeIsFirstEntry)
+{
+  ScheduleCodes::CodeMap const codes({
+      {"повар", SchedulingKeynodes::concept_cook},
+      {"официант", SchedulingKeynodes::concept_waiter},
+      {"cook", SchedulingKeynodes::concept_cook},
+      {"chef", SchedulingKeynodes::concept_cook}});
+
+  // Все коды класса находят его, обратно возвращается код из первой записи класса
+  for (char const * code : {"повар", "cook", "chef"})
+  {
+    ASSERT_NE(codes.Find(code), nullptr);
+    EXPECT_EQ(*codes.Find(code), SchedulingKeynodes::concept_cook);
+  }
+  EXPECT_EQ(codes.FindCode(SchedulingKeynodes::concept_cook), "повар");
+  EXPECT_EQ(codes.FindCode(SchedulingKeynodes::concept_waiter), "официант");
+  EXPECT_TRUE(codes.FindCode(SchedulingKeynodes::concept_admin).empty());
+
+  std::vector<ScAddr> const expectedClasses = {SchedulingKeynodes::concept_cook, SchedulingKeynodes::concept_waiter};
+  EXPECT_EQ(codes.GetClasses(), expectedClasses);
+  EXPECT_EQ(codes.Size(), 4u);
+}
+
+TEST_F(ScheduleCodesTest, LoadedOrderDoesNotDependOnDeclarationOrder)
+{
+  // Классы и коды объявляются не в том порядке, в котором должны оказаться в таблице
+  ScAddr zeta = m_ctx->GenerateNode(ScType::ConstNodeClass);
+  m_ctx->SetElementSystemIdentifier("concept_zeta_profession", zeta);
+  ScAddr alpha = m_ctx->GenerateNode(ScType::ConstNodeClass);
+  m_ctx->SetElementSystemIdentifier("concept_alpha_profession", alpha);
+
+  AddProfessionCode(*m_ctx, zeta, "zeta2");
+  AddProfessionCode(*m_ctx, zeta, "shared");
+  AddProfessionCode(*m_ctx, zeta, "zeta1");
+  AddProfessionCode(*m_ctx, alpha, "shared");
+  AddProfessionCode(*m_ctx, alpha, "alpha");
+
+  ScheduleCodes::CodeMap const codes = ScheduleCodes::LoadProfessionMap(*m_ctx);
+
+  // Классы упорядочены по системному идентификатору
+  std::vector<ScAddr> const expectedClasses = {
+      SchedulingKeynodes::concept_admin,
+      alpha,
+      SchedulingKeynodes::concept_cleaner,
+      SchedulingKeynodes::concept_cook,
+      SchedulingKeynodes::concept_waiter,
+      zeta};
+  EXPECT_EQ(codes.GetClasses(), expectedClasses);
+
+  // Канонический код — наименьший из кодов класса; общий код достаётся классу с меньшим идентификатором
+  EXPECT_EQ(codes.FindCode(zeta), "zeta1");
+  EXPECT_EQ(codes.FindCode(alpha), "alpha");
+  ASSERT_NE(codes.Find("shared"), nullptr);
+  EXPECT_EQ(*codes.Find("shared"), alpha);
+  ASSERT_NE(codes.Find("zeta2"), nullptr);
+  EXPECT_EQ(*codes.Find("zeta2"), zeta);
+  EXPECT_EQ(codes.FindCode(SchedulingKeynodes::concept_cook), "повар");
+}
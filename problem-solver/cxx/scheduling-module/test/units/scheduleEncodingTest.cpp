@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include "utils/scheduleEncoding.hpp"
+
+TEST(ScheduleEncodingTest, EncodeDecode_RoundTrip)
+{
+  EncodedSchedule schedule;
+  schedule.daysCount = 7;
+  schedule.shiftsCount = 3;
+  schedule.employeeIds = {1, 0x0102030405060708ull, 42};
+  schedule.shiftMasks = {
+      ScheduleEncoding::GetShiftBit(0, 0, 3) | ScheduleEncoding::GetShiftBit(6, 2, 3), 0, 0x1FFFFF};
+
+  std::string const data = ScheduleEncoding::Encode(schedule);
+  EXPECT_EQ(data.size(), ScheduleEncoding::HEADER_SIZE + 3 * 12);
+  EXPECT_EQ(data.substr(0, 4), "SCHD");
+
+  EncodedSchedule decoded;
+  ASSERT_TRUE(ScheduleEncoding::Decode(data, decoded));
+  EXPECT_EQ(decoded.daysCount, 7);
+  EXPECT_EQ(decoded.shiftsCount, 3);
+  EXPECT_EQ(decoded.employeeIds, schedule.employeeIds);
+  EXPECT_EQ(decoded.shiftMasks, schedule.shiftMasks);
+}
+
+TEST(ScheduleEncodingTest, Decode_EmptySchedule)
+{
+  EncodedSchedule schedule;
+  schedule.daysCount = 7;
+  schedule.shiftsCount = 3;
+
+  EncodedSchedule decoded;
+  ASSERT_TRUE(ScheduleEncoding::Decode(ScheduleEncoding::Encode(schedule), decoded));
+  EXPECT_TRUE(decoded.employeeIds.empty());
+}
+
+TEST(ScheduleEncodingTest, Decode_RejectsInvalidData)
+{
+  EncodedSchedule schedule;
+  schedule.daysCount = 7;
+  schedule.shiftsCount = 3;
+  schedule.employeeIds = {1};
+  schedule.shiftMasks = {1};
+  std::string const data = ScheduleEncoding::Encode(schedule);
+
+  EncodedSchedule decoded;
+  EXPECT_FALSE(ScheduleEncoding::Decode("", decoded));
+  EXPECT_FALSE(ScheduleEncoding::Decode("XXXX" + data.substr(4), decoded));
+  EXPECT_FALSE(ScheduleEncoding::Decode(data.substr(0, data.size() - 1), decoded));
+}
@@ -0,0 +1,164 @@
+#include <sc-memory/test/sc_test.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "agents/scheduleBuilderAgent.hpp"
+#include "agents/scheduleExportAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/TestUtils.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using ScheduleExportAgentTest = ScMemoryTest;
+
+namespace
+{
+
+ScAddr BuildSchedule(ScAgentContext & ctx)
+{
+  ScAddr requirements = TestUtils::CreateShiftRequirements(ctx, 1, 0, 0, 0, 7);
+  ScAction buildAction = TestUtils::CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(buildAction.InitiateAndWait(10000));
+  EXPECT_TRUE(buildAction.IsFinishedSuccessfully());
+  return buildAction.GetResult();
+}
+
+ScAddr CreateTextLink(ScAgentContext & ctx, std::string const & text)
+{
+  ScAddr link = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(link, text);
+  return link;
+}
+
+size_t CountLines(std::string const & text, std::string const & prefix)
+{
+  size_t count = 0;
+  std::istringstream stream(text);
+  std::string line;
+  while (std::getline(stream, line))
+  {
+    if (line.rfind(prefix, 0) == 0)
+      count++;
+  }
+  return count;
+}
+
+}  // namespace
+
+TEST_F(ScheduleExportAgentTest, ExportCsv_ToLink)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<ScheduleExportAgent>();
+
+  TestUtils::CreateEmployee(ctx, "ПоварУтро", SchedulingKeynodes::concept_cook, {SchedulingKeynodes::concept_morning_shift});
+  ScAddr schedule = BuildSchedule(ctx);
+
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_export_schedule);
+  action.SetArguments(schedule, SchedulingKeynodes::schedule_export_csv);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  ScIterator3Ptr it = ctx.CreateIterator3(action.GetResult(), ScType::ConstPermPosArc, ScType::ConstNodeLink);
+  ASSERT_TRUE(it->Next());
+  std::string csv;
+  ctx.GetLinkContent(it->Get(2), csv);
+
+  // Повар работает утром все 7 дней
+  EXPECT_EQ(csv.rfind("day,shift,profession,name\n", 0), 0u);
+  EXPECT_EQ(CountLines(csv, "monday,M,повар,ПоварУтро"), 1u);
+  EXPECT_EQ(CountLines(csv, ""), 8u);
+  EXPECT_LT(csv.find("monday"), csv.find("sunday"));
+
+  ctx.UnsubscribeAgent<ScheduleExportAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleExportAgentTest, ExportIcs_ToFile)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<ScheduleExportAgent>();
+
+  TestUtils::CreateEmployee(ctx, "ПоварУтро", SchedulingKeynodes::concept_cook, {SchedulingKeynodes::concept_morning_shift});
+  ScAddr schedule = BuildSchedule(ctx);
+
+  std::string const filePath = "schedule_export_test.ics";
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_export_schedule);
+  action.SetArguments(
+      schedule,
+      SchedulingKeynodes::schedule_export_ics,
+      CreateTextLink(ctx, filePath),
+      CreateTextLink(ctx, "2026-10-19"));
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  std::ifstream file(filePath, std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+  std::stringstream content;
+  content << file.rdbuf();
+  file.close();
+  std::remove(filePath.c_str());
+
+  std::string const ics = content.str();
+  EXPECT_EQ(CountLines(ics, "BEGIN:VEVENT"), 7u);
+  EXPECT_EQ(CountLines(ics, "DTSTART:20261019T060000"), 1u);
+  EXPECT_EQ(CountLines(ics, "DTEND:20261025T140000"), 1u);
+
+  ctx.UnsubscribeAgent<ScheduleExportAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ScheduleExportAgentTest, Export_InvalidArguments)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleExportAgent>();
+
+  ScAction missingAction = ctx.GenerateAction(SchedulingKeynodes::action_export_schedule);
+  EXPECT_TRUE(missingAction.InitiateAndWait(5000));
+  EXPECT_TRUE(missingAction.IsFinishedWithError());
+
+  ScAction notScheduleAction = ctx.GenerateAction(SchedulingKeynodes::action_export_schedule);
+  notScheduleAction.SetArguments(ctx.GenerateNode(ScType::ConstNode), SchedulingKeynodes::schedule_export_csv);
+  EXPECT_TRUE(notScheduleAction.InitiateAndWait(5000));
+  EXPECT_TRUE(notScheduleAction.IsFinishedWithError());
+
+  ctx.UnsubscribeAgent<ScheduleExportAgent>();
+}
+
+TEST_F(ScheduleExportAgentTest, Export_UnknownFormatKeepsFile)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<ScheduleExportAgent>();
+
+  TestUtils::CreateEmployee(ctx, "ПоварУтро", SchedulingKeynodes::concept_cook, {SchedulingKeynodes::concept_morning_shift});
+  ScAddr schedule = BuildSchedule(ctx);
+
+  std::string const filePath = "schedule_export_unknown_format_test.csv";
+  {
+    std::ofstream previous(filePath, std::ios::binary);
+    previous << "day,shift,profession,name\n";
+  }
+
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_export_schedule);
+  action.SetArguments(schedule, ctx.GenerateNode(ScType::ConstNode), CreateTextLink(ctx, filePath));
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedWithError());
+
+  std::ifstream file(filePath, std::ios::binary);
+  ASSERT_TRUE(file.is_open());
+  std::stringstream content;
+  content << file.rdbuf();
+  file.close();
+  std::remove(filePath.c_str());
+  EXPECT_EQ(content.str(), "day,shift,profession,name\n");
+
+  ctx.UnsubscribeAgent<ScheduleExportAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
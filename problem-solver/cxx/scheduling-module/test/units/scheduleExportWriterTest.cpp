@@ -0,0 +1,106 @@
+#include <gtest/gtest.h>
+
+#include "utils/scheduleExportWriter.hpp"
+
+#include <sstream>
+
+namespace
+{
+
+ScheduleExportRow CreateRow(size_t dayIndex, size_t shiftIndex, std::string const & name)
+{
+  ScheduleExportRow row;
+  row.dayIndex = dayIndex;
+  row.dayCode = "monday";
+  row.shiftIndex = shiftIndex;
+  row.shiftCode = "N";
+  row.profession = "повар";
+  row.name = name;
+  row.uid = 7;
+  return row;
+}
+
+}  // namespace
+
+TEST(ScheduleExportWriterTest, Csv_WritesHeaderAndRows)
+{
+  std::ostringstream out;
+  CsvScheduleWriter writer(out);
+  writer.Begin();
+  writer.Write(CreateRow(0, 2, "Иван Петров"));
+  writer.Write(CreateRow(0, 2, "Петров, \"младший\""));
+  writer.End();
+
+  EXPECT_EQ(
+      out.str(),
+      "day,shift,profession,name\n"
+      "monday,N,повар,Иван Петров\n"
+      "monday,N,повар,\"Петров, \"\"младший\"\"\"\n");
+}
+
+TEST(ScheduleExportWriterTest, Ics_NightShiftEndsNextDay)
+{
+  int64_t weekStart = 0;
+  ASSERT_TRUE(IcsScheduleWriter::ParseDate("2026-10-19", weekStart));
+
+  std::ostringstream out;
+  IcsScheduleWriter writer(out, weekStart);
+  writer.Begin();
+  writer.Write(CreateRow(6, 2, "Анна; Смирнова"));
+  writer.End();
+
+  std::string const ics = out.str();
+  EXPECT_EQ(ics.rfind("BEGIN:VCALENDAR\r\n", 0), 0u);
+  EXPECT_NE(ics.find("DTSTART:20261025T220000\r\n"), std::string::npos);
+  EXPECT_NE(ics.find("DTEND:20261026T060000\r\n"), std::string::npos);
+  EXPECT_NE(ics.find("SUMMARY:Анна\\; Смирнова (повар)\r\n"), std::string::npos);
+  EXPECT_NE(ics.find("END:VCALENDAR\r\n"), std::string::npos);
+}
+
+TEST(ScheduleExportWriterTest, Ics_FoldsLongLinesAtUtf8Boundaries)
+{
+  std::string const name = "Константинопольская-Александровская Екатерина Владимировна";
+
+  std::ostringstream out;
+  IcsScheduleWriter writer(out, 0);
+  writer.Begin();
+  writer.Write(CreateRow(0, 0, name));
+  writer.End();
+
+  // Каждая строка не длиннее 75 октетов и не начинается с середины символа UTF-8
+  std::string const ics = out.str();
+  size_t lineStart = 0;
+  while (lineStart < ics.size())
+  {
+    size_t const lineEnd = ics.find("\r\n", lineStart);
+    ASSERT_NE(lineEnd, std::string::npos);
+    EXPECT_LE(lineEnd - lineStart, IcsScheduleWriter::MAX_LINE_OCTETS);
+    size_t const contentStart = ics[lineStart] == ' ' ? lineStart + 1 : lineStart;
+    if (contentStart < lineEnd)
+    {
+      EXPECT_NE(static_cast<unsigned char>(ics[contentStart]) & 0xC0, 0x80);
+    }
+    lineStart = lineEnd + 2;
+  }
+
+  // После снятия переносов строка SUMMARY восстанавливается целиком
+  std::string unfolded = ics;
+  for (size_t fold = unfolded.find("\r\n "); fold != std::string::npos; fold = unfolded.find("\r\n ", fold))
+    unfolded.erase(fold, 3);
+  EXPECT_NE(unfolded.find("SUMMARY:" + name + " (повар)\r\n"), std::string::npos);
+  EXPECT_EQ(IcsScheduleWriter::FoldLine("CATEGORIES:N"), "CATEGORIES:N");
+}
+
+TEST(ScheduleExportWriterTest, Ics_ParseDate)
+{
+  int64_t days = 0;
+  EXPECT_TRUE(IcsScheduleWriter::ParseDate("19700101", days));
+  EXPECT_EQ(days, 0);
+  EXPECT_TRUE(IcsScheduleWriter::ParseDate("2024-02-29", days));
+  EXPECT_FALSE(IcsScheduleWriter::ParseDate("2023-02-29", days));
+  EXPECT_FALSE(IcsScheduleWriter::ParseDate("19-10-2026", days));
+  EXPECT_FALSE(IcsScheduleWriter::ParseDate("2026-10-19x", days));
+
+  int64_t const weekStart = IcsScheduleWriter::GetCurrentWeekStart();
+  EXPECT_EQ((weekStart + 3) % 7, 0);
+}
@@ -0,0 +1,100 @@
+#include <sc-memory/test/sc_test.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "agents/scheduleBuilderAgent.hpp"
+#include "agents/shiftRosterAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/TestUtils.hpp"
+
+using ShiftRosterAgentTest = ScMemoryTest;
+
+namespace
+{
+
+// Строит расписание и возвращает его структуру
+ScAddr BuildSchedule(ScAgentContext & ctx)
+{
+  ScAddr requirements = TestUtils::CreateShiftRequirements(ctx, 1, 1, 0, 0, 7);
+  ScAction buildAction = TestUtils::CreateBuildAction(ctx, requirements);
+  EXPECT_TRUE(buildAction.InitiateAndWait(10000));
+  EXPECT_TRUE(buildAction.IsFinishedSuccessfully());
+  return buildAction.GetResult();
+}
+
+ScAction CreateRosterAction(
+    ScAgentContext & ctx,
+    ScAddr const & schedule,
+    ScAddr const & day,
+    ScAddr const & shiftType)
+{
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_get_shift_roster);
+  action.SetArguments(schedule, day, shiftType);
+  return action;
+}
+
+int CountElements(ScAgentContext & ctx, ScAddr const & set)
+{
+  int count = 0;
+  ScIterator3Ptr it = ctx.CreateIterator3(set, ScType::ConstPermPosArc, ScType::Unknown);
+  while (it->Next())
+    count++;
+  return count;
+}
+
+}  // namespace
+
+TEST_F(ShiftRosterAgentTest, GetShiftRoster_ReturnsAssignedEmployees)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ScheduleBuilderAgent>();
+  ctx.SubscribeAgent<ShiftRosterAgent>();
+
+  // Повар работает только утром, официант — только ночью
+  ScAddr cook = TestUtils::CreateEmployee(
+      ctx, "ПоварУтро", SchedulingKeynodes::concept_cook, {SchedulingKeynodes::concept_morning_shift});
+  ScAddr waiter = TestUtils::CreateEmployee(
+      ctx, "ОфициантНочь", SchedulingKeynodes::concept_waiter, {SchedulingKeynodes::concept_night_shift});
+
+  ScAddr schedule = BuildSchedule(ctx);
+
+  ScAction morningAction = CreateRosterAction(
+      ctx, schedule, SchedulingKeynodes::friday, SchedulingKeynodes::concept_morning_shift);
+  EXPECT_TRUE(morningAction.InitiateAndWait(5000));
+  EXPECT_TRUE(morningAction.IsFinishedSuccessfully());
+
+  ScAddr morningRoster = morningAction.GetResult();
+  EXPECT_EQ(CountElements(ctx, morningRoster), 1);
+  EXPECT_TRUE(ctx.CheckConnector(morningRoster, cook, ScType::ConstPermPosArc));
+
+  ScAction nightAction = CreateRosterAction(
+      ctx, schedule, SchedulingKeynodes::friday, SchedulingKeynodes::concept_night_shift);
+  EXPECT_TRUE(nightAction.InitiateAndWait(5000));
+  EXPECT_TRUE(nightAction.IsFinishedSuccessfully());
+
+  ScAddr nightRoster = nightAction.GetResult();
+  EXPECT_EQ(CountElements(ctx, nightRoster), 1);
+  EXPECT_TRUE(ctx.CheckConnector(nightRoster, waiter, ScType::ConstPermPosArc));
+
+  ScAction dayAction = CreateRosterAction(
+      ctx, schedule, SchedulingKeynodes::friday, SchedulingKeynodes::concept_day_shift);
+  EXPECT_TRUE(dayAction.InitiateAndWait(5000));
+  EXPECT_TRUE(dayAction.IsFinishedSuccessfully());
+  EXPECT_EQ(CountElements(ctx, dayAction.GetResult()), 0);
+
+  ctx.UnsubscribeAgent<ShiftRosterAgent>();
+  ctx.UnsubscribeAgent<ScheduleBuilderAgent>();
+}
+
+TEST_F(ShiftRosterAgentTest, GetShiftRoster_MissingArguments)
+{
+  ScAgentContext & ctx = *m_ctx;
+
+  ctx.SubscribeAgent<ShiftRosterAgent>();
+
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_get_shift_roster);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedWithError());
+
+  ctx.UnsubscribeAgent<ShiftRosterAgent>();
+}
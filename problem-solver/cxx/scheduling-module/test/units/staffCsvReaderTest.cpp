@@ -0,0 +1,206 @@
+#include <gtest/gtest.h>
+
+#include "utils/staffCsvReader.hpp"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+std::vector<std::vector<std::string>> ReadAll(std::string_view data, char delimiter = ',')
+{
+  std::vector<std::vector<std::string>> records;
+  StaffCsvReader reader(data, delimiter);
+  CsvFields fields;
+  while (reader.NextRecord(fields))
+    records.emplace_back(fields.cbegin(), fields.cend());
+  return records;
+}
+
+std::vector<std::string> GetShiftCodes(std::string_view shifts)
+{
+  std::vector<std::string> codes;
+  StaffCsvReader::ForEachShiftCode(shifts, [&codes](std::string_view code) {
+    codes.emplace_back(code);
+  });
+  return codes;
+}
+
+using Records = std::vector<std::vector<std::string>>;
+
+}  // namespace
+
+TEST(StaffCsvReaderTest, NextRecord_SkipsBlankLinesAndTrims)
+{
+  EXPECT_EQ(
+      ReadAll("profession,name\r\n\r\n  повар,Иванов  \n   \n официант , Петров"),
+      Records({{"profession", "name"}, {"повар", "Иванов"}, {"официант", "Петров"}}));
+}
+
+TEST(StaffCsvReaderTest, NextRecord_QuotedFields)
+{
+  std::string const data =
+      "profession,name,allowed_shifts\r\n"
+      "повар,\"Петров, Иван\",M;D\r\n"
+      "официант,\"Анна \"\"Младшая\"\"\nСмирнова\",\"\"\r\n"
+      "уборщик, \"Lee\" ,N";
+
+  EXPECT_EQ(
+      ReadAll(data),
+      Records(
+          {{"profession", "name", "allowed_shifts"},
+           {"повар", "Петров, Иван", "M;D"},
+           {"официант", "Анна \"Младшая\"\nСмирнова", ""},
+           {"уборщик", "Lee", "N"}}));
+}
+
+TEST(StaffCsvReaderTest, NextRecord_UnescapedFieldsAreSlicesOfBuffer)
+{
+  std::string const data = "повар,\"Петров, Иван\"\n";
+  StaffCsvReader reader(data);
+  CsvFields fields;
+  ASSERT_TRUE(reader.NextRecord(fields));
+  ASSERT_EQ(fields.size(), 2u);
+  EXPECT_EQ(fields[1].data(), data.data() + data.find("Петров"));
+}
+
+TEST(StaffCsvReaderTest, NextRecord_BomAndDelimiter)
+{
+  EXPECT_EQ(
+      ReadAll("\xEF\xBB\xBFprofession;name;allowed_shifts\nповар;Иванов;\"M;D\"\n", ';'),
+      Records({{"profession", "name", "allowed_shifts"}, {"повар", "Иванов", "M;D"}}));
+  EXPECT_EQ(ReadAll("повар\tИванов\t\tN\n", '\t'), Records({{"повар", "Иванов", "", "N"}}));
+}
+
+TEST(StaffCsvReaderTest, NextRecord_UnterminatedQuoteTakesRest)
+{
+  EXPECT_EQ(ReadAll("повар,\"Иванов\nN"), Records({{"повар", "Иванов\nN"}}));
+}
+
+TEST(StaffCsvReaderTest, SplitChunks_AlignedToRecords)
+{
+  std::string data;
+  for (int i = 0; i < 200; ++i)
+  {
+    // Каждая третья запись содержит перевод строки в кавычках
+    std::string const id = std::to_string(i);
+    data += i % 3 == 0 ? "повар,\"Имя\n" + id + "\",M\n" : "официант,Имя" + id + ",D\n";
+  }
+
+  Records const expected = ReadAll(data);
+  for (size_t chunkCount : {1u, 2u, 3u, 7u, 64u})
+  {
+    auto const chunks = StaffCsvReader::SplitChunks(data, chunkCount);
+    EXPECT_LE(chunks.size(), chunkCount);
+
+    std::string joined;
+    Records records;
+    for (auto const & chunk : chunks)
+    {
+      EXPECT_EQ(chunk.data(), data.data() + joined.size());
+      joined += chunk;
+      for (auto & record : ReadAll(chunk))
+        records.push_back(record);
+    }
+    EXPECT_EQ(joined, data);
+    EXPECT_EQ(records, expected);
+  }
+}
+
+TEST(StaffCsvReaderTest, SplitChunks_StrayQuoteInUnquotedField)
+{
+  // Кавычка внутри поля без кавычек — обычный символ и не должна сдвигать последующие границы
+  std::string data = "повар;Ива\"нов;M\n";
+  for (int i = 0; i < 100; ++i)
+  {
+    std::string const id = std::to_string(i);
+    data += i % 4 == 0 ? "повар;\"Имя\n" + id + "\";M \"x\"\n" : "официант;Имя" + id + ";D\n";
+  }
+
+  Records const expected = ReadAll(data, ';');
+  ASSERT_EQ(expected.front(), (std::vector<std::string>{"повар", "Ива\"нов", "M"}));
+  for (size_t chunkCount : {2u, 3u, 7u, 64u})
+  {
+    auto const chunks = StaffCsvReader::SplitChunks(data, chunkCount, ';');
+    EXPECT_GT(chunks.size(), 1u);
+
+    Records records;
+    for (auto const & chunk : chunks)
+    {
+      for (auto & record : ReadAll(chunk, ';'))
+        records.push_back(record);
+    }
+    EXPECT_EQ(records, expected);
+  }
+}
+
+TEST(StaffCsvReaderTest, SplitChunks_SingleLongRecord)
+{
+  std::string const data = "повар,\"" + std::string(100, '\n') + "\",M";
+  auto const chunks = StaffCsvReader::SplitChunks(data, 8);
+  ASSERT_EQ(chunks.size(), 1u);
+  EXPECT_EQ(chunks.front(), data);
+  EXPECT_EQ(StaffCsvReader::SplitChunks("", 4).size(), 1u);
+}
+
+TEST(StaffCsvReaderTest, ParseRow_ThirdColumnFollowsHeader)
+{
+  CsvFormat format;
+  format.columnCount = 3;
+  format.hasForbiddenColumn = true;
+
+  StaffCsvRecord record;
+  StaffCsvReader::ParseRow({"повар", "Антонов", "N"}, format, record);
+  EXPECT_EQ(record.allowedShifts, "");
+  EXPECT_EQ(record.forbiddenShifts, "N");
+
+  format.hasForbiddenColumn = false;
+  format.hasAllowedColumn = true;
+  StaffCsvReader::ParseRow({"повар", "Антонов"}, format, record);
+  EXPECT_EQ(record.name, "Антонов");
+  EXPECT_EQ(record.allowedShifts, "");
+  EXPECT_EQ(record.forbiddenShifts, "");
+
+  format.columnCount = 4;
+  StaffCsvReader::ParseRow({"повар", "Антонов", "", "N", "лишнее"}, format, record);
+  EXPECT_EQ(record.allowedShifts, "");
+  EXPECT_EQ(record.forbiddenShifts, "N");
+}
+
+TEST(StaffCsvReaderTest, ParseRow_IdColumnAnywhere)
+{
+  CsvFormat format;
+  format.columnCount = 3;
+  format.idColumn = 1;
+
+  StaffCsvRecord record;
+  StaffCsvReader::ParseRow({"повар", "E-17", "Антонов", "M;D"}, format, record);
+  EXPECT_EQ(record.id, "E-17");
+  EXPECT_EQ(record.profession, "повар");
+  EXPECT_EQ(record.name, "Антонов");
+  EXPECT_EQ(record.allowedShifts, "M;D");
+}
+
+TEST(StaffCsvReaderTest, ParseRow_IdAndOpColumns)
+{
+  CsvFormat format;
+  format.columnCount = 3;
+  format.idColumn = 2;
+  format.opColumn = 0;
+
+  StaffCsvRecord record;
+  StaffCsvReader::ParseRow({"remove", "повар", "E-17", "Антонов", "M;D"}, format, record);
+  EXPECT_EQ(record.op, "remove");
+  EXPECT_EQ(record.id, "E-17");
+  EXPECT_EQ(record.profession, "повар");
+  EXPECT_EQ(record.name, "Антонов");
+  EXPECT_EQ(record.allowedShifts, "M;D");
+}
+
+TEST(StaffCsvReaderTest, ForEachShiftCode_SkipsEmptyCodes)
+{
+  EXPECT_EQ(GetShiftCodes(" M ; D;;N; "), std::vector<std::string>({"M", "D", "N"}));
+  EXPECT_TRUE(GetShiftCodes("").empty());
+  EXPECT_TRUE(GetShiftCodes(" ; ").empty());
+}
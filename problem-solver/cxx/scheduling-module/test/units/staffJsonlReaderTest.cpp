@@ -0,0 +1,122 @@
+#include <gtest/gtest.h>
+
+#include "utils/staffJsonlReader.hpp"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// Поля копируются: срезы записи действительны только до следующего вызова NextRecord
+struct OwnedRecord
+{
+  std::string id;
+  std::string profession;
+  std::string name;
+  std::string allowedShifts;
+  std::string forbiddenShifts;
+};
+
+std::vector<OwnedRecord> ReadAll(StaffJsonlReader & reader)
+{
+  std::vector<OwnedRecord> records;
+  StaffCsvRecord record;
+  while (reader.NextRecord(record))
+  {
+    records.push_back(
+        {std::string(record.id),
+         std::string(record.profession),
+         std::string(record.name),
+         std::string(record.allowedShifts),
+         std::string(record.forbiddenShifts)});
+  }
+  return records;
+}
+
+}  // namespace
+
+TEST(StaffJsonlReaderTest, ReadsFieldsAsSlices)
+{
+  std::string const data =
+      "{\"id\": \"E-1\", \"op\": \"add\", \"profession\": \"повар\", \"name\": \"Иванов\", "
+      "\"allowed_shifts\": \"M;D\", \"forbidden_shifts\": \"N\"}\n";
+  StaffJsonlReader reader(data);
+
+  StaffCsvRecord record;
+  ASSERT_TRUE(reader.NextRecord(record));
+  EXPECT_EQ(record.id, "E-1");
+  EXPECT_EQ(record.op, "add");
+  EXPECT_EQ(record.profession, "повар");
+  EXPECT_EQ(record.name, "Иванов");
+  EXPECT_EQ(record.allowedShifts, "M;D");
+  EXPECT_EQ(record.forbiddenShifts, "N");
+  EXPECT_GE(record.name.data(), data.data());
+  EXPECT_LT(record.name.data(), data.data() + data.size());
+  EXPECT_FALSE(reader.NextRecord(record));
+  EXPECT_EQ(reader.GetInvalidCount(), 0u);
+}
+
+TEST(StaffJsonlReaderTest, EscapesArraysAndUnknownFields)
+{
+  std::string const data =
+      "\xEF\xBB\xBF{\"name\":\"Петров \\\"младший\\\"\",\"profession\":\"\\u043f\\u043e\\u0432\\u0430\\u0440\","
+      "\"allowed_shifts\":[\"M\", \"N\"],\"meta\":{\"tags\":[1,true,null,{\"a\":\"}\"}]},\"id\":17}\r\n"
+      "\r\n"
+      "{\"name\":\"\\ud83d\\ude00\",\"profession\":\"повар\",\"forbidden_shifts\":null}";
+  StaffJsonlReader reader(data);
+
+  auto const records = ReadAll(reader);
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].name, "Петров \"младший\"");
+  EXPECT_EQ(records[0].profession, "повар");
+  EXPECT_EQ(records[0].allowedShifts, "M;N");
+  EXPECT_EQ(records[0].id, "17");
+  EXPECT_EQ(records[1].name, "\xF0\x9F\x98\x80");
+  EXPECT_TRUE(records[1].forbiddenShifts.empty());
+}
+
+TEST(StaffJsonlReaderTest, SkipsInvalidLines)
+{
+  std::string const data =
+      "{\"name\":\"Первый\",\"profession\":\"повар\"}\n"
+      "{\"name\":\"Незакрытый\"\n"
+      "[\"not\", \"an\", \"object\"]\n"
+      "{\"name\":\"Хвост\"} лишнее\n"
+      "{\"name\":\"\\x\"}\n"
+      "{\"name\":\"Последний\",\"profession\":\"повар\"}\n";
+  StaffJsonlReader reader(data);
+
+  auto const records = ReadAll(reader);
+  ASSERT_EQ(records.size(), 2u);
+  EXPECT_EQ(records[0].name, "Первый");
+  EXPECT_EQ(records[1].name, "Последний");
+  EXPECT_EQ(reader.GetInvalidCount(), 4u);
+  EXPECT_EQ(reader.GetFirstInvalidLine(), 2u);
+}
+
+TEST(StaffJsonlReaderTest, SplitChunks_EndOnLines)
+{
+  std::string data;
+  for (int i = 0; i < 100; ++i)
+    data += "{\"name\":\"Сотрудник " + std::to_string(i) + "\",\"profession\":\"повар\"}\n";
+
+  auto const chunks = StaffJsonlReader::SplitChunks(data, 7);
+  EXPECT_GT(chunks.size(), 1u);
+
+  size_t total = 0;
+  size_t records = 0;
+  for (auto const & chunk : chunks)
+  {
+    EXPECT_EQ(chunk.back(), '\n');
+    total += chunk.size();
+
+    StaffJsonlReader reader(chunk);
+    StaffCsvRecord record;
+    while (reader.NextRecord(record))
+      records++;
+    EXPECT_EQ(reader.GetInvalidCount(), 0u);
+  }
+  EXPECT_EQ(total, data.size());
+  EXPECT_EQ(records, 100u);
+}
@@ -0,0 +1,155 @@
+#include <sc-memory/test/sc_test.hpp>
+#include <sc-memory/sc_memory.hpp>
+
+#include "agents/exportStaffSnapshotAgent.hpp"
+#include "agents/importStaffFromSnapshotAgent.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "utils/TestUtils.hpp"
+#include "utils/staffSnapshot.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+using StaffSnapshotAgentTest = ScMemoryTest;
+
+namespace
+{
+
+ScAction CreateSnapshotImportAction(ScAgentContext & ctx, std::string const & data)
+{
+  ScAddr action = ctx.GenerateNode(ScType::ConstNode);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_import_staff_from_snapshot, action);
+
+  ScAddr link = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(link, data);
+  ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, action, link);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_file_content, arc);
+  return ctx.ConvertToAction(action);
+}
+
+}  // namespace
+
+TEST_F(StaffSnapshotAgentTest, ExportToFile)
+{
+  ScAgentContext & ctx = *m_ctx;
+  ctx.SubscribeAgent<ExportStaffSnapshotAgent>();
+
+  TestUtils::CreateEmployee(
+      ctx, "Иванов", SchedulingKeynodes::concept_cook,
+      {SchedulingKeynodes::concept_morning_shift, SchedulingKeynodes::concept_day_shift},
+      {SchedulingKeynodes::concept_night_shift});
+  TestUtils::CreateEmployee(ctx, "Петров", SchedulingKeynodes::concept_waiter, {SchedulingKeynodes::concept_day_shift});
+
+  std::string const path = (std::filesystem::temp_directory_path() / "staff_snapshot_agent_test.bin").string();
+  ScAddr pathLink = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(pathLink, path);
+
+  ScAction action = ctx.GenerateAction(SchedulingKeynodes::action_export_staff_snapshot);
+  action.SetArguments(pathLink);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  std::ifstream file(path, std::ios::binary);
+  std::ostringstream content;
+  content << file.rdbuf();
+
+  StaffSnapshot snapshot;
+  std::string error;
+  ASSERT_TRUE(StaffSnapshotCodec::Decode(content.str(), snapshot, error)) << error;
+  ASSERT_EQ(snapshot.employees.size(), 2u);
+  for (auto const & employee : snapshot.employees)
+  {
+    if (employee.name == "Иванов")
+    {
+      EXPECT_EQ(snapshot.professions[employee.profession], "concept_cook");
+      EXPECT_EQ(employee.allowedShifts.size(), 2u);
+      ASSERT_EQ(employee.forbiddenShifts.size(), 1u);
+      EXPECT_EQ(snapshot.shifts[employee.forbiddenShifts[0]], "concept_night_shift");
+    }
+    else
+    {
+      EXPECT_EQ(employee.name, "Петров");
+      EXPECT_EQ(snapshot.professions[employee.profession], "concept_waiter");
+    }
+  }
+
+  std::filesystem::remove(path);
+  ctx.UnsubscribeAgent<ExportStaffSnapshotAgent>();
+}
+
+TEST_F(StaffSnapshotAgentTest, ImportRestoresStaff)
+{
+  m_ctx->SubscribeAgent<ImportStaffFromSnapshotAgent>();
+
+  StaffSnapshot snapshot;
+  snapshot.professions = {"concept_cook", "concept_unknown_profession"};
+  snapshot.shifts = {"concept_morning_shift", "concept_night_shift"};
+  snapshot.employees.push_back({"E-1", "Иванов", 0, {0}, {1}});
+  snapshot.employees.push_back({"E-2", "Зотов", 1, {0}, {}});
+
+  ScAction action = CreateSnapshotImportAction(*m_ctx, StaffSnapshotCodec::Encode(snapshot));
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  ScAddr ivanov = TestUtils::FindEmployeeByName(*m_ctx, "Иванов");
+  ASSERT_TRUE(ivanov.IsValid());
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_cook, ivanov, ScType::ConstPermPosArc));
+  EXPECT_TRUE(TestUtils::HasAllowedShift(*m_ctx, ivanov, SchedulingKeynodes::concept_morning_shift));
+  EXPECT_EQ(TestUtils::CountAllowedShifts(*m_ctx, ivanov), 1);
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Зотов").IsValid());
+
+  m_ctx->UnsubscribeAgent<ImportStaffFromSnapshotAgent>();
+}
+
+TEST_F(StaffSnapshotAgentTest, ImportSkipsUnresolvedRestrictionsAndNonProfessions)
+{
+  m_ctx->SubscribeAgent<ImportStaffFromSnapshotAgent>();
+
+  StaffSnapshot snapshot;
+  snapshot.professions = {"concept_cook", "concept_morning_shift"};
+  snapshot.shifts = {"concept_morning_shift", "concept_unknown_shift"};
+  // Без неизвестной запрещённой смены Иванова можно было бы поставить на неё
+  snapshot.employees.push_back({"E-1", "Иванов", 0, {0}, {1}});
+  // Смена с системным идентификатором не является профессией
+  snapshot.employees.push_back({"E-2", "Зотов", 1, {0}, {}});
+  snapshot.employees.push_back({"E-3", "Петров", 0, {0}, {}});
+  std::string const data = StaffSnapshotCodec::Encode(snapshot);
+
+  // В режиме import_staff_atomic снимок отвергается целиком
+  ScAction atomicAction = CreateSnapshotImportAction(*m_ctx, data);
+  m_ctx->GenerateConnector(ScType::ConstPermPosArc, atomicAction, SchedulingKeynodes::import_staff_atomic);
+  EXPECT_TRUE(atomicAction.InitiateAndWait(5000));
+  EXPECT_TRUE(atomicAction.IsFinishedWithError());
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Петров").IsValid());
+
+  ScAction action = CreateSnapshotImportAction(*m_ctx, data);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedSuccessfully());
+
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Иванов").IsValid());
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Зотов").IsValid());
+  ScAddr petrov = TestUtils::FindEmployeeByName(*m_ctx, "Петров");
+  ASSERT_TRUE(petrov.IsValid());
+  EXPECT_TRUE(m_ctx->CheckConnector(SchedulingKeynodes::concept_cook, petrov, ScType::ConstPermPosArc));
+
+  m_ctx->UnsubscribeAgent<ImportStaffFromSnapshotAgent>();
+}
+
+TEST_F(StaffSnapshotAgentTest, ImportRejectsCorruptedSnapshot)
+{
+  m_ctx->SubscribeAgent<ImportStaffFromSnapshotAgent>();
+
+  StaffSnapshot snapshot;
+  snapshot.professions = {"concept_cook"};
+  snapshot.employees.push_back({"", "Иванов", 0, {}, {}});
+  std::string data = StaffSnapshotCodec::Encode(snapshot);
+  data[data.size() / 2] ^= 0x01;
+
+  ScAction action = CreateSnapshotImportAction(*m_ctx, data);
+  EXPECT_TRUE(action.InitiateAndWait(5000));
+  EXPECT_TRUE(action.IsFinishedWithError());
+  EXPECT_FALSE(TestUtils::FindEmployeeByName(*m_ctx, "Иванов").IsValid());
+
+  m_ctx->UnsubscribeAgent<ImportStaffFromSnapshotAgent>();
+}
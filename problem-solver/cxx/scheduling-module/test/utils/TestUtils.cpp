@@ -84,4 +84,107 @@ int GetEmployeeWorkloadByName(ScAgentContext & ctx, std::string const & name)
   return GetEmployeeWorkload(ctx, emp);
 }
 
+// Создаёт тестового сотрудника
+ScAddr CreateEmployee(
+    ScAgentContext & ctx,
+    std::string const & name,
+    ScAddr const & profession,
+    std::vector<ScAddr> const & allowedShifts,
+    std::vector<ScAddr> const & forbiddenShifts)
+{
+  ScAddr emp = ctx.GenerateNode(ScType::ConstNode);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, profession, emp);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_employee, emp);
+  
+  // Имя
+  ScAddr nameLink = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(nameLink, name);
+  ScAddr nameArc = ctx.GenerateConnector(ScType::ConstCommonArc, emp, nameLink);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, ScKeynodes::nrel_main_idtf, nameArc);
+  
+  // Разрешённые смены
+  for (auto const & shift : allowedShifts)
+  {
+    ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, emp, shift);
+    ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_allowed_shift, arc);
+  }
+  
+  // Запрещённые смены
+  for (auto const & shift : forbiddenShifts)
+  {
+    ScAddr arc = ctx.GenerateConnector(ScType::ConstCommonArc, emp, shift);
+    ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_can_not_work, arc);
+  }
+  
+  return emp;
+}
+
+// Создаёт требования к составу смены
+ScAddr CreateShiftRequirements(
+    ScAgentContext & ctx,
+    int cooks,
+    int waiters,
+    int cleaners,
+    int admins,
+    int maxShiftsPerWeek)
+{
+  ScAddr reqs = ctx.GenerateNode(ScType::ConstNode);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_shift_requirements, reqs);
+  
+  // Количество поваров
+  ScAddr cookCount = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(cookCount, std::to_string(cooks));
+  ScAddr arcCook = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_cook, cookCount);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcCook);
+  
+  // Количество официантов
+  ScAddr waiterCount = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(waiterCount, std::to_string(waiters));
+  ScAddr arcWaiter = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_waiter, waiterCount);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcWaiter);
+  
+  // Количество уборщиков
+  ScAddr cleanerCount = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(cleanerCount, std::to_string(cleaners));
+  ScAddr arcCleaner = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_cleaner, cleanerCount);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcCleaner);
+  
+  // Количество администраторов
+  ScAddr adminCount = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(adminCount, std::to_string(admins));
+  ScAddr arcAdmin = ctx.GenerateConnector(ScType::ConstCommonArc, SchedulingKeynodes::concept_admin, adminCount);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_required_count, arcAdmin);
+  
+  // Максимум смен в неделю
+  ScAddr maxLink = ctx.GenerateLink(ScType::ConstNodeLink);
+  ctx.SetLinkContent(maxLink, std::to_string(maxShiftsPerWeek));
+  ScAddr arcMax = ctx.GenerateConnector(ScType::ConstCommonArc, reqs, maxLink);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_max_shifts_per_week, arcMax);
+  
+  return reqs;
+}
+
+// Создаёт действие построения расписания: требования — rrel_1, дополнительные параметры — rrel_2, rrel_3, ...
+ScAction CreateBuildAction(
+    ScAgentContext & ctx,
+    ScAddr const & requirements,
+    std::vector<ScAddr> const & options)
+{
+  ScAddr action = ctx.GenerateNode(ScType::ConstNode);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::action_build_weekly_schedule, action);
+
+  ScAddr arcReqs = ctx.GenerateConnector(ScType::ConstPermPosArc, action, requirements);
+  ctx.GenerateConnector(ScType::ConstPermPosArc, ScKeynodes::rrel_1, arcReqs);
+
+  std::vector<ScAddr> const roles = {
+      ScKeynodes::rrel_2, ScKeynodes::rrel_3, ScKeynodes::rrel_4, ScKeynodes::rrel_5, ScKeynodes::rrel_6};
+  for (size_t i = 0; i < options.size() && i < roles.size(); ++i)
+  {
+    ScAddr arcOption = ctx.GenerateConnector(ScType::ConstPermPosArc, action, options[i]);
+    ctx.GenerateConnector(ScType::ConstPermPosArc, roles[i], arcOption);
+  }
+
+  return ctx.ConvertToAction(action);
+}
+
 }  // namespace TestUtils
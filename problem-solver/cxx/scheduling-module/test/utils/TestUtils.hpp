@@ -3,6 +3,7 @@
 #include <sc-memory/sc_memory.hpp>
 #include <sc-memory/sc_agent_context.hpp>
 #include <string>
+#include <vector>
 #include "../../keynodes/scheduling-keynodes.hpp"
 
 namespace TestUtils
@@ -26,4 +27,27 @@ int GetEmployeeWorkload(ScAgentContext & ctx, ScAddr const & employee);
 // Получает загруженность сотрудника по имени
 int GetEmployeeWorkloadByName(ScAgentContext & ctx, std::string const & name);
 
+// Создаёт тестового сотрудника
+ScAddr CreateEmployee(
+    ScAgentContext & ctx,
+    std::string const & name,
+    ScAddr const & profession,
+    std::vector<ScAddr> const & allowedShifts = {},
+    std::vector<ScAddr> const & forbiddenShifts = {});
+
+// Создаёт требования к составу смены
+ScAddr CreateShiftRequirements(
+    ScAgentContext & ctx,
+    int cooks,
+    int waiters,
+    int cleaners,
+    int admins,
+    int maxShiftsPerWeek);
+
+// Создаёт действие построения расписания: требования — rrel_1, дополнительные параметры — rrel_2, rrel_3, ...
+ScAction CreateBuildAction(
+    ScAgentContext & ctx,
+    ScAddr const & requirements,
+    std::vector<ScAddr> const & options = {});
+
 }  // namespace TestUtils
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+// Двухстадийный конвейер по блокам: produce(i) выполняется для блоков 0..count-1 в отдельном
+// потоке, а consume(i) — в вызывающем потоке, как только блок i готов. Пока обрабатывается
+// готовый блок, следующий уже вычисляется. Исключения обеих стадий передаются вызывающему
+template <typename TProduce, typename TConsume>
+void RunBlockPipeline(size_t count, TProduce && produce, TConsume && consume)
+{
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::deque<size_t> ready;
+  bool finished = false;
+  bool cancelled = false;
+  std::exception_ptr producerError;
+
+  std::thread producer([&] {
+    try
+    {
+      for (size_t i = 0; i < count; ++i)
+      {
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (cancelled)
+            break;
+        }
+        produce(i);
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          ready.push_back(i);
+        }
+        condition.notify_one();
+      }
+    }
+    catch (...)
+    {
+      producerError = std::current_exception();
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      finished = true;
+    }
+    condition.notify_one();
+  });
+
+  std::exception_ptr consumerError;
+  try
+  {
+    while (true)
+    {
+      size_t block = 0;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return !ready.empty() || finished; });
+        if (ready.empty())
+          break;
+        block = ready.front();
+        ready.pop_front();
+      }
+      consume(block);
+    }
+  }
+  catch (...)
+  {
+    consumerError = std::current_exception();
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled = true;
+  }
+
+  producer.join();
+
+  if (producerError)
+    std::rethrow_exception(producerError);
+  if (consumerError)
+    std::rethrow_exception(consumerError);
+}
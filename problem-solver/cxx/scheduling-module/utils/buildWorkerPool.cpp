@@ -0,0 +1,94 @@
+#include "buildWorkerPool.hpp"
+
+#include <algorithm>
+
+BuildWorkerPool & BuildWorkerPool::GetInstance()
+{
+  static BuildWorkerPool pool;
+  return pool;
+}
+
+BuildWorkerPool::~BuildWorkerPool()
+{
+  Shutdown();
+}
+
+void BuildWorkerPool::SetConcurrencyLimit(size_t limit)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_concurrencyLimit = std::max<size_t>(limit, 1);
+  }
+  m_condition.notify_all();
+}
+
+size_t BuildWorkerPool::GetConcurrencyLimit() const
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  return m_concurrencyLimit;
+}
+
+void BuildWorkerPool::Submit(std::function<void()> task)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_tasks.push_back(std::move(task));
+
+    // Потоки создаются по мере необходимости, но не больше лимита
+    if (m_workers.size() < m_concurrencyLimit)
+      m_workers.emplace_back(&BuildWorkerPool::WorkerLoop, this);
+  }
+  m_condition.notify_all();
+}
+
+void BuildWorkerPool::WorkerLoop()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true)
+  {
+    m_condition.wait(lock, [this] {
+      return (m_stopping && m_tasks.empty()) || (!m_tasks.empty() && m_runningTasks < m_concurrencyLimit);
+    });
+
+    if (m_tasks.empty())
+      return;
+
+    std::function<void()> task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+    ++m_runningTasks;
+
+    lock.unlock();
+    try
+    {
+      task();
+    }
+    catch (...)
+    {
+      // Задача сама сообщает об ошибке; исключение не должно останавливать поток пула
+    }
+    lock.lock();
+
+    --m_runningTasks;
+    m_condition.notify_all();
+  }
+}
+
+void BuildWorkerPool::Shutdown()
+{
+  std::vector<std::thread> workers;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+    workers.swap(m_workers);
+  }
+  m_condition.notify_all();
+
+  for (std::thread & worker : workers)
+  {
+    if (worker.joinable())
+      worker.join();
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_stopping = false;
+}
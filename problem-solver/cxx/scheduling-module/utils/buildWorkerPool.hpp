@@ -0,0 +1,45 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков для асинхронного построения расписаний.
+// Одновременно выполняется не больше GetConcurrencyLimit() задач, остальные ждут в очереди
+class BuildWorkerPool
+{
+public:
+  static constexpr size_t DEFAULT_CONCURRENCY_LIMIT = 2;
+
+  static BuildWorkerPool & GetInstance();
+
+  BuildWorkerPool() = default;
+  ~BuildWorkerPool();
+
+  BuildWorkerPool(BuildWorkerPool const &) = delete;
+  BuildWorkerPool & operator=(BuildWorkerPool const &) = delete;
+
+  void SetConcurrencyLimit(size_t limit);
+  size_t GetConcurrencyLimit() const;
+
+  void Submit(std::function<void()> task);
+
+  // Дожидается выполнения всех поставленных задач и останавливает потоки.
+  // После остановки пул можно использовать снова
+  void Shutdown();
+
+private:
+  void WorkerLoop();
+
+  mutable std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::function<void()>> m_tasks;
+  std::vector<std::thread> m_workers;
+  size_t m_concurrencyLimit = DEFAULT_CONCURRENCY_LIMIT;
+  size_t m_runningTasks = 0;
+  bool m_stopping = false;
+};
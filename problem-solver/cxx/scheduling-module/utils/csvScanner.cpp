@@ -0,0 +1,118 @@
+#include "csvScanner.hpp"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#  define SCHEDULING_CSV_SCANNER_X86
+#  include <immintrin.h>
+#endif
+
+namespace
+{
+
+size_t FindStructuralScalar(char const * data, size_t size, size_t from, char delimiter)
+{
+  for (size_t i = from; i < size; ++i)
+  {
+    char const c = data[i];
+    if (c == delimiter || c == '"' || c == '\n' || c == '\r')
+      return i;
+  }
+  return size;
+}
+
+#ifdef SCHEDULING_CSV_SCANNER_X86
+
+size_t FindStructuralSse2(char const * data, size_t size, size_t from, char delimiter)
+{
+  __m128i const delimiters = _mm_set1_epi8(delimiter);
+  __m128i const quotes = _mm_set1_epi8('"');
+  __m128i const lineFeeds = _mm_set1_epi8('\n');
+  __m128i const carriageReturns = _mm_set1_epi8('\r');
+
+  size_t i = from;
+  for (; i + 16 <= size; i += 16)
+  {
+    __m128i const chunk = _mm_loadu_si128(reinterpret_cast<__m128i const *>(data + i));
+    __m128i const matches = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, delimiters), _mm_cmpeq_epi8(chunk, quotes)),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, lineFeeds), _mm_cmpeq_epi8(chunk, carriageReturns)));
+    unsigned const mask = static_cast<unsigned>(_mm_movemask_epi8(matches));
+    if (mask != 0)
+      return i + __builtin_ctz(mask);
+  }
+  return FindStructuralScalar(data, size, i, delimiter);
+}
+
+// Собирается под AVX2 без флагов компилятора; вызывается только при поддержке процессором
+__attribute__((target("avx2"))) size_t FindStructuralAvx2(
+    char const * data, size_t size, size_t from, char delimiter)
+{
+  __m256i const delimiters = _mm256_set1_epi8(delimiter);
+  __m256i const quotes = _mm256_set1_epi8('"');
+  __m256i const lineFeeds = _mm256_set1_epi8('\n');
+  __m256i const carriageReturns = _mm256_set1_epi8('\r');
+
+  size_t i = from;
+  for (; i + 32 <= size; i += 32)
+  {
+    __m256i const chunk = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(data + i));
+    __m256i const matches = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, delimiters), _mm256_cmpeq_epi8(chunk, quotes)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(chunk, lineFeeds), _mm256_cmpeq_epi8(chunk, carriageReturns)));
+    unsigned const mask = static_cast<unsigned>(_mm256_movemask_epi8(matches));
+    if (mask != 0)
+      return i + __builtin_ctz(mask);
+  }
+  return FindStructuralSse2(data, size, i, delimiter);
+}
+
+#endif
+
+}  // namespace
+
+bool CsvScanner::IsSupported(CsvScanMode mode)
+{
+  switch (mode)
+  {
+  case CsvScanMode::Scalar:
+    return true;
+#ifdef SCHEDULING_CSV_SCANNER_X86
+  case CsvScanMode::Sse2:
+    return true;
+  case CsvScanMode::Avx2:
+    return __builtin_cpu_supports("avx2");
+#endif
+  default:
+    return false;
+  }
+}
+
+CsvScanMode CsvScanner::GetDefaultMode()
+{
+  static CsvScanMode const mode = IsSupported(CsvScanMode::Avx2)   ? CsvScanMode::Avx2
+                                  : IsSupported(CsvScanMode::Sse2) ? CsvScanMode::Sse2
+                                                                   : CsvScanMode::Scalar;
+  return mode;
+}
+
+size_t CsvScanner::FindStructural(std::string_view data, size_t from, char delimiter)
+{
+  return FindStructural(data, from, delimiter, GetDefaultMode());
+}
+
+size_t CsvScanner::FindStructural(std::string_view data, size_t from, char delimiter, CsvScanMode mode)
+{
+  if (from >= data.size())
+    return data.size();
+
+  switch (mode)
+  {
+#ifdef SCHEDULING_CSV_SCANNER_X86
+  case CsvScanMode::Avx2:
+    return FindStructuralAvx2(data.data(), data.size(), from, delimiter);
+  case CsvScanMode::Sse2:
+    return FindStructuralSse2(data.data(), data.size(), from, delimiter);
+#endif
+  default:
+    return FindStructuralScalar(data.data(), data.size(), from, delimiter);
+  }
+}
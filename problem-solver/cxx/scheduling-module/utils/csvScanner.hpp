@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+
+// Реализация поиска структурных символов CSV
+enum class CsvScanMode
+{
+  Scalar,  // Побайтовый просмотр
+  Sse2,    // 16 байт за шаг
+  Avx2     // 32 байта за шаг
+};
+
+// Поиск следующего структурного символа CSV: разделителя, кавычки, '\n' или '\r'.
+// На x86 используется AVX2, если его поддерживает процессор, иначе SSE2; на остальных платформах — побайтовый просмотр
+class CsvScanner
+{
+public:
+  // Позиция первого структурного символа начиная с from или data.size(), если его нет
+  static size_t FindStructural(std::string_view data, size_t from, char delimiter);
+  // Режим должен поддерживаться процессором (IsSupported)
+  static size_t FindStructural(std::string_view data, size_t from, char delimiter, CsvScanMode mode);
+
+  static bool IsSupported(CsvScanMode mode);
+  static CsvScanMode GetDefaultMode();
+};
@@ -0,0 +1,129 @@
+#include "importTransaction.hpp"
+
+#include <tuple>
+#include <unordered_map>
+
+ImportTransaction::ImportTransaction(ScMemoryContext & context)
+  : m_context(context)
+{
+}
+
+ImportTransaction::Guard::Guard(ImportTransaction & transaction)
+  : m_transaction(transaction)
+{
+}
+
+// Деструктор не должен выпускать исключения: ошибка отката уже ничего не изменит для вызывающего
+ImportTransaction::Guard::~Guard()
+{
+  try
+  {
+    if (m_transaction.GetChangeCount() > 0)
+      m_transaction.Rollback();
+  }
+  catch (...)
+  {
+  }
+}
+
+ScAddr ImportTransaction::GenerateNode(ScType const & type)
+{
+  ScAddr const node = m_context.GenerateNode(type);
+  m_changes.push_back({ChangeKind::Created, node, 0});
+  return node;
+}
+
+ScAddr ImportTransaction::GenerateLink(ScType const & type)
+{
+  ScAddr const link = m_context.GenerateLink(type);
+  m_changes.push_back({ChangeKind::Created, link, 0});
+  return link;
+}
+
+ScAddr ImportTransaction::GenerateConnector(ScType const & type, ScAddr const & source, ScAddr const & target)
+{
+  ScAddr const connector = m_context.GenerateConnector(type, source, target);
+  m_changes.push_back({ChangeKind::Created, connector, 0});
+  return connector;
+}
+
+void ImportTransaction::SetLinkContent(ScAddr const & link, std::string const & content)
+{
+  std::string previous;
+  m_context.GetLinkContent(link, previous);
+  m_changes.push_back({ChangeKind::ContentChanged, link, m_previousContents.size()});
+  m_previousContents.push_back(std::move(previous));
+  m_context.SetLinkContent(link, content);
+}
+
+void ImportTransaction::EraseConnector(ScAddr const & connector)
+{
+  ErasedConnector erased;
+  erased.type = m_context.GetElementType(connector);
+  std::tie(erased.source, erased.target) = m_context.GetConnectorIncidentElements(connector);
+
+  ScIterator3Ptr it = m_context.CreateIterator3(ScType::Unknown, ScType::ConstPermPosArc, connector);
+  while (it->Next())
+    erased.relations.emplace_back(it->Get(0), it->Get(1));
+
+  m_changes.push_back({ChangeKind::Erased, connector, m_erasedConnectors.size()});
+  m_erasedConnectors.push_back(std::move(erased));
+  m_context.EraseElement(connector);
+}
+
+void ImportTransaction::Commit()
+{
+  m_changes.clear();
+  m_erasedConnectors.clear();
+  m_previousContents.clear();
+}
+
+// Восстановленные дуги получают новые адреса (освобождённые адреса могут переиспользоваться),
+// поэтому более ранние записи о них отменяются по новому адресу
+size_t ImportTransaction::Rollback()
+{
+  std::unordered_map<ScAddr, ScAddr, ScAddrHashFunc> restored;
+  auto const resolve = [&restored](ScAddr const & element) {
+    auto const it = restored.find(element);
+    return it != restored.cend() ? it->second : element;
+  };
+
+  size_t const changeCount = m_changes.size();
+  for (auto change = m_changes.crbegin(); change != m_changes.crend(); ++change)
+  {
+    ScAddr const element = resolve(change->element);
+    switch (change->kind)
+    {
+    case ChangeKind::Created:
+      if (m_context.IsElement(element))
+        m_context.EraseElement(element);
+      break;
+    case ChangeKind::ContentChanged:
+      if (m_context.IsElement(element))
+        m_context.SetLinkContent(element, m_previousContents[change->detail]);
+      break;
+    case ChangeKind::Erased:
+    {
+      ErasedConnector const & erased = m_erasedConnectors[change->detail];
+      ScAddr const source = resolve(erased.source);
+      ScAddr const target = resolve(erased.target);
+      if (!m_context.IsElement(source) || !m_context.IsElement(target))
+        break;
+
+      ScAddr const connector = m_context.GenerateConnector(erased.type, source, target);
+      restored[change->element] = connector;
+      for (auto const & [relation, membership] : erased.relations)
+        restored[membership] = m_context.GenerateConnector(ScType::ConstPermPosArc, resolve(relation), connector);
+      break;
+    }
+    }
+  }
+
+  Commit();
+  return changeCount;
+}
+
+size_t ImportTransaction::GetChangeCount() const
+{
+  return m_changes.size();
+}
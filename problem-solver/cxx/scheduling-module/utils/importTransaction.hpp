@@ -0,0 +1,74 @@
+#pragma once
+
+#include <sc-memory/sc_memory.hpp>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// Журнал изменений импорта: запоминает созданные элементы, удалённые дуги и прежнее содержимое ссылок,
+// чтобы при ошибке вернуть память в состояние до импорта. Подтверждение только очищает журнал,
+// поэтому успешный импорт платит лишь за добавление адреса в вектор на каждый созданный элемент
+class ImportTransaction
+{
+public:
+  // Откатывает журнал при выходе из области видимости, если до этого не был вызван Commit,
+  // в том числе при любом исключении во время записи
+  class Guard
+  {
+  public:
+    explicit Guard(ImportTransaction & transaction);
+    ~Guard();
+
+    Guard(Guard const &) = delete;
+    Guard & operator=(Guard const &) = delete;
+
+  private:
+    ImportTransaction & m_transaction;
+  };
+
+  explicit ImportTransaction(ScMemoryContext & context);
+
+  ScAddr GenerateNode(ScType const & type);
+  ScAddr GenerateLink(ScType const & type);
+  ScAddr GenerateConnector(ScType const & type, ScAddr const & source, ScAddr const & target);
+  void SetLinkContent(ScAddr const & link, std::string const & content);
+
+  // Удаляет дугу вместе с входящими в неё дугами принадлежности (отношения), запоминая их для отката
+  void EraseConnector(ScAddr const & connector);
+
+  void Commit();
+
+  // Отменяет изменения в обратном порядке, возвращает количество отменённых изменений
+  size_t Rollback();
+
+  size_t GetChangeCount() const;
+
+private:
+  enum class ChangeKind
+  {
+    Created,
+    Erased,
+    ContentChanged
+  };
+
+  struct Change
+  {
+    ChangeKind kind;
+    ScAddr element;
+    size_t detail;  // Индекс в m_erasedConnectors или m_previousContents
+  };
+
+  struct ErasedConnector
+  {
+    ScType type;
+    ScAddr source;
+    ScAddr target;
+    std::vector<std::pair<ScAddr, ScAddr>> relations;  // Отношение и дуга принадлежности
+  };
+
+  ScMemoryContext & m_context;
+  std::vector<Change> m_changes;
+  std::vector<ErasedConnector> m_erasedConnectors;
+  std::vector<std::string> m_previousContents;
+};
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Реестр выполняющихся построений: одинаковые запросы, пришедшие во время построения,
+// не запускают его заново, а дожидаются результата первого запроса
+template <typename TResult>
+class InFlightRegistry
+{
+public:
+  struct Ticket
+  {
+    bool isOwner = false;
+    std::shared_future<TResult> result;
+  };
+
+  // Первый запрос по ключу становится владельцем и обязан вызвать Complete
+  Ticket Acquire(std::string const & key)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_builds.find(key);
+    if (it != m_builds.cend())
+      return {false, it->second.result};
+
+    Entry & entry = m_builds[key];
+    entry.promise = std::make_shared<std::promise<TResult>>();
+    entry.result = entry.promise->get_future().share();
+    return {true, entry.result};
+  }
+
+  // Вызывает continuation с результатом построения в потоке владельца, когда тот вызовет Complete.
+  // Возвращает false, если построение по ключу уже завершилось: результат тогда готов в билете
+  bool AddContinuation(std::string const & key, std::function<void(TResult const &)> continuation)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto const it = m_builds.find(key);
+    if (it == m_builds.cend())
+      return false;
+
+    it->second.continuations.push_back(std::move(continuation));
+    return true;
+  }
+
+  void Complete(std::string const & key, TResult const & value)
+  {
+    std::shared_ptr<std::promise<TResult>> promise;
+    std::vector<std::function<void(TResult const &)>> continuations;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      auto const it = m_builds.find(key);
+      if (it == m_builds.cend())
+        return;
+      promise = it->second.promise;
+      continuations.swap(it->second.continuations);
+      m_builds.erase(it);
+    }
+    promise->set_value(value);
+
+    for (auto const & continuation : continuations)
+      continuation(value);
+  }
+
+  size_t GetSize() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_builds.size();
+  }
+
+private:
+  struct Entry
+  {
+    std::shared_ptr<std::promise<TResult>> promise;
+    std::shared_future<TResult> result;
+    std::vector<std::function<void(TResult const &)>> continuations;
+  };
+
+  mutable std::mutex m_mutex;
+  std::unordered_map<std::string, Entry> m_builds;
+};
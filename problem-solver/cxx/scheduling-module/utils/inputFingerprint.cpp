@@ -0,0 +1,34 @@
+#include "inputFingerprint.hpp"
+
+#include <cstdio>
+
+void InputFingerprint::AddByte(unsigned char byte)
+{
+  m_hash ^= byte;
+  m_hash *= 1099511628211ull;
+}
+
+void InputFingerprint::Add(uint64_t value)
+{
+  for (size_t i = 0; i < sizeof(value); ++i)
+    AddByte(static_cast<unsigned char>((value >> (8 * i)) & 0xFF));
+}
+
+void InputFingerprint::Add(std::string const & value)
+{
+  Add(static_cast<uint64_t>(value.size()));
+  for (char c : value)
+    AddByte(static_cast<unsigned char>(c));
+}
+
+uint64_t InputFingerprint::GetHash() const
+{
+  return m_hash;
+}
+
+std::string InputFingerprint::ToString() const
+{
+  char buffer[17];
+  std::snprintf(buffer, sizeof(buffer), "%016llx", static_cast<unsigned long long>(m_hash));
+  return buffer;
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Отпечаток входных данных построения (FNV-1a, 64 бита).
+// Значения добавляются в фиксированном порядке, неупорядоченные множества нужно сортировать заранее
+class InputFingerprint
+{
+public:
+  void Add(uint64_t value);
+  void Add(std::string const & value);
+
+  uint64_t GetHash() const;
+  std::string ToString() const;
+
+private:
+  void AddByte(unsigned char byte);
+
+  uint64_t m_hash = 14695981039346656037ull;
+};
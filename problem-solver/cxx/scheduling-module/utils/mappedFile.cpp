@@ -0,0 +1,102 @@
+#include "mappedFile.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+MappedFile::MappedFile(MappedFile && other) noexcept
+  : m_data(std::exchange(other.m_data, nullptr))
+  , m_size(std::exchange(other.m_size, 0))
+  , m_isOpen(std::exchange(other.m_isOpen, false))
+  , m_error(std::move(other.m_error))
+{
+}
+
+MappedFile & MappedFile::operator=(MappedFile && other) noexcept
+{
+  if (this != &other)
+  {
+    Close();
+    m_data = std::exchange(other.m_data, nullptr);
+    m_size = std::exchange(other.m_size, 0);
+    m_isOpen = std::exchange(other.m_isOpen, false);
+    m_error = std::move(other.m_error);
+  }
+  return *this;
+}
+
+bool MappedFile::Open(std::string const & path)
+{
+  Close();
+
+  int const fd = ::open(path.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    m_error = "Cannot open " + path + ": " + std::strerror(errno);
+    return false;
+  }
+
+  struct stat info;
+  if (::fstat(fd, &info) == -1 || !S_ISREG(info.st_mode))
+  {
+    m_error = "Not a regular file: " + path;
+    ::close(fd);
+    return false;
+  }
+
+  // Пустой файл отобразить нельзя, но это корректный файл без содержимого
+  m_size = static_cast<size_t>(info.st_size);
+  if (m_size > 0)
+  {
+    void * data = ::mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+      m_error = "Cannot map " + path + ": " + std::strerror(errno);
+      m_size = 0;
+      ::close(fd);
+      return false;
+    }
+    m_data = data;
+    ::madvise(m_data, m_size, MADV_SEQUENTIAL);
+  }
+
+  // Отображение остаётся действительным после закрытия дескриптора
+  ::close(fd);
+  m_isOpen = true;
+  m_error.clear();
+  return true;
+}
+
+void MappedFile::Close()
+{
+  if (m_data != nullptr)
+    ::munmap(m_data, m_size);
+  m_data = nullptr;
+  m_size = 0;
+  m_isOpen = false;
+}
+
+bool MappedFile::IsOpen() const
+{
+  return m_isOpen;
+}
+
+std::string_view MappedFile::GetContent() const
+{
+  return {static_cast<char const *>(m_data), m_size};
+}
+
+std::string const & MappedFile::GetError() const
+{
+  return m_error;
+}
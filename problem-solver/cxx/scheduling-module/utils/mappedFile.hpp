@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Отображение файла в память только для чтения. Содержимое не копируется в кучу процесса:
+// страницы подгружаются операционной системой по мере чтения
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(MappedFile const &) = delete;
+  MappedFile & operator=(MappedFile const &) = delete;
+  MappedFile(MappedFile && other) noexcept;
+  MappedFile & operator=(MappedFile && other) noexcept;
+
+  // Возвращает false, если файл не удалось открыть или отобразить; причина — в GetError()
+  bool Open(std::string const & path);
+  void Close();
+
+  bool IsOpen() const;
+  std::string_view GetContent() const;
+  std::string const & GetError() const;
+
+private:
+  void * m_data = nullptr;
+  size_t m_size = 0;
+  bool m_isOpen = false;
+  std::string m_error;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Выполняет func(shard) для shard = 0..count-1 параллельно: нулевой шард — в вызывающем потоке,
+// остальные — в отдельных. Дожидается всех шардов и передаёт вызывающему первое исключение
+template <typename TFunc>
+void RunShards(size_t count, TFunc && func)
+{
+  std::vector<std::exception_ptr> errors(count);
+  std::vector<std::thread> threads;
+  threads.reserve(count > 0 ? count - 1 : 0);
+
+  for (size_t shard = 1; shard < count; ++shard)
+  {
+    threads.emplace_back([&func, &errors, shard] {
+      try
+      {
+        func(shard);
+      }
+      catch (...)
+      {
+        errors[shard] = std::current_exception();
+      }
+    });
+  }
+
+  if (count > 0)
+  {
+    try
+    {
+      func(0);
+    }
+    catch (...)
+    {
+      errors[0] = std::current_exception();
+    }
+  }
+
+  for (std::thread & thread : threads)
+    thread.join();
+
+  for (std::exception_ptr const & error : errors)
+  {
+    if (error)
+      std::rethrow_exception(error);
+  }
+}
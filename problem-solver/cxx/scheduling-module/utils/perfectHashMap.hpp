@@ -0,0 +1,132 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Неизменяемая таблица строковых ключей с минимальной совершенной хеш-функцией (hash and displace):
+// ключ сначала попадает в корзину, а сохранённое для корзины смещение переводит его в собственную ячейку.
+// Поиск — два хеша и одно сравнение строк, без выделения памяти
+template <typename TValue>
+class PerfectHashMap
+{
+public:
+  using Entry = std::pair<std::string, TValue>;
+
+  PerfectHashMap() = default;
+
+  // Повторяющиеся ключи недопустимы
+  explicit PerfectHashMap(std::vector<Entry> entries)
+  {
+    size_t const size = entries.size();
+    if (size == 0)
+      return;
+
+    std::vector<std::string_view> keys(size);
+    std::transform(entries.cbegin(), entries.cend(), keys.begin(), [](Entry const & entry) {
+      return std::string_view(entry.first);
+    });
+    std::sort(keys.begin(), keys.end());
+    auto const duplicate = std::adjacent_find(keys.cbegin(), keys.cend());
+    if (duplicate != keys.cend())
+      throw std::invalid_argument("PerfectHashMap: duplicate key " + std::string(*duplicate));
+
+    std::vector<std::vector<size_t>> buckets(size);
+    for (size_t i = 0; i < size; ++i)
+      buckets[Hash(entries[i].first, 0) % size].push_back(i);
+
+    // Большие корзины размещаются первыми, пока свободных ячеек много
+    std::vector<size_t> order(size);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&buckets](size_t left, size_t right) {
+      return buckets[left].size() > buckets[right].size();
+    });
+
+    m_seeds.assign(size, 0);
+    std::vector<bool> occupied(size, false);
+    std::vector<size_t> slots(size);
+    std::vector<size_t> bucketSlots;
+    for (size_t bucket : order)
+    {
+      auto const & bucketKeys = buckets[bucket];
+      if (bucketKeys.empty())
+        break;
+
+      for (uint32_t seed = 1;; ++seed)
+      {
+        bucketSlots.clear();
+        for (size_t key : bucketKeys)
+        {
+          size_t const slot = Hash(entries[key].first, seed) % size;
+          if (occupied[slot] || std::find(bucketSlots.cbegin(), bucketSlots.cend(), slot) != bucketSlots.cend())
+            break;
+          bucketSlots.push_back(slot);
+        }
+        if (bucketSlots.size() < bucketKeys.size())
+          continue;
+
+        m_seeds[bucket] = seed;
+        for (size_t i = 0; i < bucketKeys.size(); ++i)
+        {
+          occupied[bucketSlots[i]] = true;
+          slots[bucketKeys[i]] = bucketSlots[i];
+        }
+        break;
+      }
+    }
+
+    m_entries.resize(size);
+    for (size_t i = 0; i < size; ++i)
+      m_entries[slots[i]] = std::move(entries[i]);
+  }
+
+  TValue const * Find(std::string_view key) const
+  {
+    if (m_entries.empty())
+      return nullptr;
+
+    size_t const size = m_entries.size();
+    Entry const & entry = m_entries[Hash(key, m_seeds[Hash(key, 0) % size]) % size];
+    return entry.first == key ? &entry.second : nullptr;
+  }
+
+  size_t Size() const
+  {
+    return m_entries.size();
+  }
+
+  // Обход в порядке ячеек таблицы
+  typename std::vector<Entry>::const_iterator begin() const
+  {
+    return m_entries.cbegin();
+  }
+
+  typename std::vector<Entry>::const_iterator end() const
+  {
+    return m_entries.cend();
+  }
+
+private:
+  std::vector<Entry> m_entries;
+  std::vector<uint32_t> m_seeds;
+
+  // FNV-1a с затравкой и перемешиванием старших битов
+  static uint64_t Hash(std::string_view key, uint32_t seed)
+  {
+    uint64_t hash = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for (unsigned char const symbol : key)
+    {
+      hash ^= symbol;
+      hash *= 1099511628211ull;
+    }
+    hash ^= hash >> 33;
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= hash >> 33;
+    return hash;
+  }
+};
@@ -0,0 +1,1390 @@
+#include "scheduleBuilder.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+#include "scheduleCodes.hpp"
+#include "scheduleCollector.hpp"
+#include "scheduleEncoding.hpp"
+#include "inputFingerprint.hpp"
+#include "inFlightRegistry.hpp"
+#include "blockPipeline.hpp"
+#include "parallelShards.hpp"
+#include "solver/scheduleSolver.hpp"
+
+#include <sc-memory/sc_memory_headers.hpp>
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+
+namespace
+{
+
+InFlightRegistry<ScAddr> & GetInFlightBuilds()
+{
+  static InFlightRegistry<ScAddr> builds;
+  return builds;
+}
+
+// Сообщает ожидающим запросам результат построения при любом выходе из него, в том числе при ошибке
+struct InFlightBuildGuard
+{
+  InFlightBuildGuard(std::string key, bool isOwner)
+    : key(std::move(key))
+    , isOwner(isOwner)
+  {
+  }
+
+  ~InFlightBuildGuard()
+  {
+    if (isOwner)
+      GetInFlightBuilds().Complete(key, result);
+  }
+
+  std::string key;
+  bool isOwner;
+  ScAddr result;
+};
+
+}  // namespace
+
+ScheduleBuilder::ScheduleBuilder(ScAgentContext & context, utils::ScLogger & logger)
+  : m_context(context)
+  , m_logger(logger)
+{
+}
+
+std::vector<ScAddr> ScheduleBuilder::GetWeekdays()
+{
+  return ScheduleCodes::GetWeekdays();
+}
+
+std::vector<ScAddr> ScheduleBuilder::GetShiftTypes()
+{
+  return ScheduleCodes::GetShiftTypes();
+}
+
+std::string ScheduleBuilder::GetEmployeeName(ScAddr const & employee)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      employee, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      ScKeynodes::nrel_main_idtf);
+  if (it->Next())
+  {
+    std::string name;
+    m_context.GetLinkContent(it->Get(2), name);
+    return name;
+  }
+  return "Unknown";
+}
+
+int ScheduleBuilder::GetIntFromLink(ScAddr const & link, int defaultValue)
+{
+  if (!link.IsValid())
+    return defaultValue;
+
+  std::string content;
+  m_context.GetLinkContent(link, content);
+
+  try
+  {
+    return std::stoi(content);
+  }
+  catch (...)
+  {
+    return defaultValue;
+  }
+}
+
+// Число сотрудников на смену для профессий без nrel_required_count: встроенные профессии
+// сохраняют прежние значения по умолчанию, добавленные в базу знаний без количества не назначаются
+int ScheduleBuilder::GetDefaultRequiredCount(ScAddr const & profession)
+{
+  if (profession == SchedulingKeynodes::concept_waiter)
+    return 2;
+  if (profession == SchedulingKeynodes::concept_cook || profession == SchedulingKeynodes::concept_cleaner ||
+      profession == SchedulingKeynodes::concept_admin)
+    return 1;
+  return 0;
+}
+
+// Вспомогательный метод для получения требуемого количества профессии
+int ScheduleBuilder::GetRequiredCount(ScAddr const & profession, int defaultValue)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      profession, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_required_count);
+  if (it->Next())
+    return GetIntFromLink(it->Get(2), defaultValue);
+  return defaultValue;
+}
+
+
+// Расписание строится для всех профессий кодовой таблицы (nrel_profession_code), поэтому
+// профессия, добавленная в базу знаний, попадает в расписание без пересборки модуля
+ShiftRequirements ScheduleBuilder::GetShiftRequirements(ScAction & action)
+{
+  ShiftRequirements reqs;
+
+  auto const & [requirementsAddr] = action.GetArguments<1>();
+  auto const professions = ScheduleCodes::LoadProfessionMap(m_context).GetClasses();
+
+  if (!requirementsAddr.IsValid())
+  {
+    m_logger.Info("ScheduleBuilderAgent: No requirements provided, using defaults");
+    for (ScAddr const & profession : professions)
+      reqs.professionCounts.emplace_back(profession, GetDefaultRequiredCount(profession));
+    return reqs;
+  }
+
+  m_logger.Info("ScheduleBuilderAgent: Parsing shift requirements from input");
+
+  for (ScAddr const & profession : professions)
+    reqs.professionCounts.emplace_back(profession, GetRequiredCount(profession, GetDefaultRequiredCount(profession)));
+
+  ScIterator5Ptr itMax = m_context.CreateIterator5(
+      requirementsAddr, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_max_shifts_per_week);
+  if (itMax->Next())
+    reqs.maxShiftsPerWeek = GetIntFromLink(itMax->Get(2), reqs.maxShiftsPerWeek);
+
+  ScIterator5Ptr itStored = m_context.CreateIterator5(
+      requirementsAddr, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_max_stored_schedules);
+  if (itStored->Next())
+    reqs.maxStoredSchedules = GetIntFromLink(itStored->Get(2), reqs.maxStoredSchedules);
+
+  return reqs;
+}
+
+// Уровень сохранения графа передаётся аргументом действия (по умолчанию — полный)
+GraphPersistenceLevel ScheduleBuilder::GetGraphPersistenceLevel(ScAction & action)
+{
+  if (m_context.CheckConnector(action, SchedulingKeynodes::graph_persistence_none, ScType::ConstPermPosArc))
+    return GraphPersistenceLevel::None;
+
+  if (m_context.CheckConnector(action, SchedulingKeynodes::graph_persistence_matched_edges, ScType::ConstPermPosArc))
+    return GraphPersistenceLevel::MatchedEdges;
+
+  return GraphPersistenceLevel::Full;
+}
+
+// Вспомогательный метод для получения множества смен сотрудника
+ScAddrUnorderedSet ScheduleBuilder::GetEmployeeShifts(
+    ScAddr const & employee, ScAddr const & relation)
+{
+  ScAddrUnorderedSet shifts;
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      employee, ScType::ConstCommonArc, ScType::ConstNode, ScType::ConstPermPosArc, relation);
+  while (it->Next())
+    shifts.insert(it->Get(2));
+  return shifts;
+}
+
+std::vector<Employee> ScheduleBuilder::GetEmployeesByProfession(ScAddr const & profession)
+{
+  std::vector<Employee> employees;
+
+  ScIterator3Ptr it = m_context.CreateIterator3(profession, ScType::ConstPermPosArc, ScType::ConstNode);
+
+  while (it->Next())
+  {
+    ScAddr empAddr = it->Get(2);
+    Employee emp;
+    emp.addr = empAddr;
+    emp.profession = profession;
+    emp.name = GetEmployeeName(empAddr);
+    emp.assignedCount = 0;
+    emp.allowedShifts = GetEmployeeShifts(empAddr, SchedulingKeynodes::nrel_allowed_shift);
+    emp.forbiddenShifts = GetEmployeeShifts(empAddr, SchedulingKeynodes::nrel_can_not_work);
+
+    employees.push_back(emp);
+  }
+
+  return employees;
+}
+
+bool ScheduleBuilder::CanWorkShift(Employee const & emp, ScAddr const & shiftType)
+{
+  if (!emp.allowedShifts.empty())
+    return emp.allowedShifts.count(shiftType) > 0;
+
+  if (!emp.forbiddenShifts.empty())
+    return emp.forbiddenShifts.count(shiftType) == 0;
+
+  return true;
+}
+
+// ===== Построение двудольного графа =====
+
+void ScheduleBuilder::BuildEmployeesPart(
+    BipartiteGraph & graph, std::vector<std::pair<ScAddr, int>> const & professionRequirements)
+{
+  int employeeIndex = 0;
+  for (auto const & [profession, count] : professionRequirements)
+  {
+    if (count > 0)
+    {
+      auto employees = GetEmployeesByProfession(profession);
+      for (auto & emp : employees)
+      {
+        emp.index = employeeIndex++;
+        graph.employees.push_back(emp);
+      }
+    }
+  }
+  m_logger.Info("ScheduleBuilderAgent: Left part (employees): ", graph.employees.size());
+}
+
+void ScheduleBuilder::BuildSlotsPart(
+    BipartiteGraph & graph,
+    std::vector<std::pair<ScAddr, int>> const & professionRequirements,
+    std::vector<ScAddr> const & weekdays,
+    std::vector<ScAddr> const & shiftTypes)
+{
+  int slotIndex = 0;
+  for (auto const & day : weekdays)
+  {
+    for (auto const & shiftType : shiftTypes)
+    {
+      for (auto const & [profession, count] : professionRequirements)
+      {
+        for (int pos = 0; pos < count; ++pos)
+        {
+          ShiftSlot slot;
+          slot.day = day;
+          slot.shiftType = shiftType;
+          slot.profession = profession;
+          slot.position = pos;
+          slot.index = slotIndex++;
+          graph.slots.push_back(slot);
+        }
+      }
+    }
+  }
+  m_logger.Info("ScheduleBuilderAgent: Right part (shift slots): ", graph.slots.size());
+}
+
+// Переводит доли графа в плотные индексы: дни, смены и профессии нумеруются по порядку в запросе
+void ScheduleBuilder::BuildSchedulingProblem(
+    BipartiteGraph & graph,
+    std::vector<std::pair<ScAddr, int>> const & professionRequirements,
+    std::vector<ScAddr> const & weekdays,
+    std::vector<ScAddr> const & shiftTypes,
+    int maxShiftsPerWeek)
+{
+  auto const getIndex = [](std::vector<ScAddr> const & addrs, ScAddr const & addr) -> size_t {
+    return std::find(addrs.cbegin(), addrs.cend(), addr) - addrs.cbegin();
+  };
+
+  std::vector<ScAddr> professions;
+  for (auto const & requirement : professionRequirements)
+    professions.push_back(requirement.first);
+
+  ScheduleProblem & problem = graph.problem;
+  problem.dayCount = weekdays.size();
+  problem.shiftCount = shiftTypes.size();
+  problem.professionCount = professions.size();
+  problem.maxShiftsPerWeek = maxShiftsPerWeek;
+
+  for (auto const & emp : graph.employees)
+  {
+    ProblemEmployee problemEmployee;
+    problemEmployee.profession = getIndex(professions, emp.profession);
+    for (auto const & shiftType : shiftTypes)
+      problemEmployee.availableShifts.push_back(CanWorkShift(emp, shiftType));
+    problem.employees.push_back(problemEmployee);
+  }
+
+  for (auto const & slot : graph.slots)
+  {
+    problem.slots.push_back(
+        {getIndex(weekdays, slot.day), getIndex(shiftTypes, slot.shiftType), getIndex(professions, slot.profession),
+         slot.position});
+  }
+}
+
+BipartiteGraph ScheduleBuilder::BuildBipartiteGraph(
+    ShiftRequirements const & reqs,
+    std::vector<ScAddr> const & weekdays,
+    std::vector<ScAddr> const & shiftTypes)
+{
+  m_logger.Info("ScheduleBuilderAgent: Building bipartite graph");
+
+  BipartiteGraph graph;
+  auto const & professionRequirements = reqs.professionCounts;
+
+  BuildEmployeesPart(graph, professionRequirements);
+  BuildSlotsPart(graph, professionRequirements, weekdays, shiftTypes);
+  BuildSchedulingProblem(graph, professionRequirements, weekdays, shiftTypes, reqs.maxShiftsPerWeek);
+
+  return graph;
+}
+
+// ===== Сохранение графа в SC-memory =====
+
+ScAddr ScheduleBuilder::CreateGraphNode()
+{
+  ScAddr graphNode = m_context.GenerateNode(ScType::ConstNode);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_bipartite_graph, graphNode);
+  return graphNode;
+}
+
+ScAddr ScheduleBuilder::CreateGraphPart(ScAddr const & graphNode, ScAddr const & relation)
+{
+  ScAddr part = m_context.GenerateNode(ScType::ConstNode);
+  ScAddr arc = m_context.GenerateConnector(ScType::ConstCommonArc, graphNode, part);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, relation, arc);
+  return part;
+}
+
+void ScheduleBuilder::AddEmployeesToPart(ScAddr const & leftPart, std::vector<Employee> const & employees)
+{
+  for (auto const & emp : employees)
+    m_context.GenerateConnector(ScType::ConstPermPosArc, leftPart, emp.addr);
+}
+
+ScAddr ScheduleBuilder::GetAttribute(ScAddr const & element, ScAddr const & relation)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      element, ScType::ConstCommonArc, ScType::Unknown, ScType::ConstPermPosArc, relation);
+  return it->Next() ? it->Get(2) : ScAddr::Empty;
+}
+
+// Загружает уже существующие узлы слотов, чтобы не создавать их заново при каждом построении.
+// Слоты профессии находятся по входящим в неё дугам nrel_slot_profession, поэтому слоты профессий,
+// не входящих в запрос, не просматриваются. Атрибуты слота читаются одним проходом по его дугам
+ShiftSlotRegistry ScheduleBuilder::LoadSlotRegistry(std::vector<ShiftSlot> const & slots)
+{
+  std::unordered_map<ScAddr, int, ScAddrHashFunc> positionsPerProfession;
+  for (auto const & slot : slots)
+  {
+    int & positions = positionsPerProfession[slot.profession];
+    positions = std::max(positions, slot.position + 1);
+  }
+
+  ShiftSlotRegistry registry;
+  for (auto const & [profession, positions] : positionsPerProfession)
+  {
+    ScIterator5Ptr itSlot = m_context.CreateIterator5(
+        ScType::ConstNode, ScType::ConstCommonArc, profession, ScType::ConstPermPosArc,
+        SchedulingKeynodes::nrel_slot_profession);
+    while (itSlot->Next())
+    {
+      ScAddr slotNode = itSlot->Get(0);
+      ShiftSlotKey key{ScAddr::Empty, ScAddr::Empty, profession, -1};
+
+      ScIterator5Ptr itAttribute = m_context.CreateIterator5(
+          slotNode, ScType::ConstCommonArc, ScType::Unknown, ScType::ConstPermPosArc, ScType::ConstNodeNonRole);
+      while (itAttribute->Next())
+      {
+        ScAddr const relation = itAttribute->Get(4);
+        if (relation == SchedulingKeynodes::nrel_shift_day)
+          key.day = itAttribute->Get(2);
+        else if (relation == SchedulingKeynodes::nrel_shift_type)
+          key.shiftType = itAttribute->Get(2);
+        else if (relation == SchedulingKeynodes::nrel_slot_position)
+          key.position = GetIntFromLink(itAttribute->Get(2), -1);
+      }
+
+      if (key.position >= 0 && key.position < positions)
+        registry.emplace(key, slotNode);
+    }
+  }
+
+  m_logger.Info("ScheduleBuilderAgent: Slot registry loaded, known slots: ", registry.size());
+  return registry;
+}
+
+ScAddr ScheduleBuilder::GetOrCreateSlotNode(ShiftSlotRegistry & registry, ShiftSlot const & slot)
+{
+  ShiftSlotKey key{slot.day, slot.shiftType, slot.profession, slot.position};
+  auto it = registry.find(key);
+  if (it != registry.end())
+    return it->second;
+
+  ScAddr slotNode = CreateSlotNode(slot);
+  registry.emplace(key, slotNode);
+  return slotNode;
+}
+
+ScAddr ScheduleBuilder::CreateSlotNode(ShiftSlot const & slot)
+{
+  ScAddr slotNode = m_context.GenerateNode(ScType::ConstNode);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_shift_slot, slotNode);
+
+  // Связываем слот с атрибутами
+  auto createSlotRelation = [this, slotNode](ScAddr const & value, ScAddr const & relation) {
+    ScAddr arc = m_context.GenerateConnector(ScType::ConstCommonArc, slotNode, value);
+    m_context.GenerateConnector(ScType::ConstPermPosArc, relation, arc);
+  };
+
+  createSlotRelation(slot.day, SchedulingKeynodes::nrel_shift_day);
+  createSlotRelation(slot.shiftType, SchedulingKeynodes::nrel_shift_type);
+  createSlotRelation(slot.profession, SchedulingKeynodes::nrel_slot_profession);
+
+  ScAddr positionLink = m_context.GenerateLink(ScType::ConstNodeLink);
+  m_context.SetLinkContent(positionLink, std::to_string(slot.position));
+  createSlotRelation(positionLink, SchedulingKeynodes::nrel_slot_position);
+
+  return slotNode;
+}
+
+void ScheduleBuilder::CreateGraphEdgesInMemory(
+    ScAddr const & graphNode,
+    std::vector<Employee> const & employees,
+    std::vector<ShiftSlot> const & slots,
+    std::vector<int> const & matching,
+    std::vector<ScAddr> const & slotAddrs)
+{
+  // Создаём рёбра только для пар, входящих в максимальное паросочетание
+  for (size_t slotIdx = 0; slotIdx < matching.size(); ++slotIdx)
+  {
+    int empIdx = matching[slotIdx];
+    if (empIdx != -1)  // Только если слот назначен сотруднику
+    {
+      auto const & emp = employees[empIdx];
+      ScAddr arcCanWork = m_context.GenerateConnector(ScType::ConstCommonArc, emp.addr, slotAddrs[slotIdx]);
+      m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_can_work, arcCanWork);
+      // Узлы слотов общие для всех построений, поэтому ребро относим к своему графу
+      m_context.GenerateConnector(ScType::ConstPermPosArc, graphNode, arcCanWork);
+    }
+  }
+}
+
+ScAddr ScheduleBuilder::SaveBipartiteGraphToScMemory(
+    BipartiteGraph const & graph,
+    std::vector<int> const & matching,
+    GraphPersistenceLevel level)
+{
+  if (level == GraphPersistenceLevel::None)
+  {
+    m_logger.Info("ScheduleBuilderAgent: Bipartite graph persistence skipped");
+    return ScAddr::Empty;
+  }
+
+  ScAddr graphNode = CreateGraphNode();
+
+  // При сохранении только паросочетания пропускаем незанятые слоты и сотрудников без смен
+  std::vector<Employee> leftPartEmployees;
+  if (level == GraphPersistenceLevel::Full)
+    leftPartEmployees = graph.employees;
+  else
+  {
+    std::vector<bool> isMatched(graph.employees.size(), false);
+    for (int empIdx : matching)
+    {
+      if (empIdx != -1)
+        isMatched[empIdx] = true;
+    }
+    for (auto const & emp : graph.employees)
+    {
+      if (isMatched[emp.index])
+        leftPartEmployees.push_back(emp);
+    }
+  }
+
+  ScAddr leftPart = CreateGraphPart(graphNode, SchedulingKeynodes::nrel_left_part);
+  AddEmployeesToPart(leftPart, leftPartEmployees);
+
+  ScAddr rightPart = CreateGraphPart(graphNode, SchedulingKeynodes::nrel_right_part);
+
+  ShiftSlotRegistry slotRegistry = LoadSlotRegistry(graph.slots);
+  size_t const knownSlots = slotRegistry.size();
+
+  std::vector<ScAddr> slotAddrs(graph.slots.size());
+  for (size_t i = 0; i < graph.slots.size(); ++i)
+  {
+    if (level == GraphPersistenceLevel::Full || matching[i] != -1)
+    {
+      slotAddrs[i] = GetOrCreateSlotNode(slotRegistry, graph.slots[i]);
+      m_context.GenerateConnector(ScType::ConstPermPosArc, rightPart, slotAddrs[i]);
+    }
+  }
+
+  m_logger.Info("ScheduleBuilderAgent: New slot nodes created: ", slotRegistry.size() - knownSlots);
+
+  // Сохраняем только рёбра из максимального паросочетания
+  CreateGraphEdgesInMemory(graphNode, graph.employees, graph.slots, matching, slotAddrs);
+
+  m_logger.Info("ScheduleBuilderAgent: Bipartite graph saved to SC-memory with maximum matching");
+  return graphNode;
+}
+
+// ===== Решение задачи (scheduling-core) =====
+
+// Паросочетание строится по блокам в отдельном потоке; назначения готового блока
+// записываются в SC-memory, пока решается следующий
+void ScheduleBuilder::SolveAndPersistAssignments(
+    BipartiteGraph const & graph,
+    PreviousSchedule const & previous,
+    size_t writers,
+    ScStructure & result,
+    std::vector<int> & matching,
+    std::vector<ShiftAssignment> & assignments,
+    std::vector<ScAddr> & assignmentNodes,
+    std::vector<ScAddr> & addedAssignments)
+{
+  ScheduleSolver solver(graph.problem);
+  auto const & blocks = solver.GetBlocks();
+  std::vector<int> iterations(blocks.size(), 0);
+
+  m_logger.Info("ScheduleBuilderAgent: Starting Kuhn's algorithm");
+  m_logger.Info("ScheduleBuilderAgent: Employees: ", graph.employees.size(), ", Slots: ", graph.slots.size(),
+                ", Edges: ", solver.GetEdgeCount(), ", Max shifts/week: ", graph.problem.maxShiftsPerWeek,
+                ", Blocks: ", blocks.size());
+
+  // Решатель меняет только слоты решаемого блока, готовые блоки читаются из его решения
+  RunBlockPipeline(
+      blocks.size(),
+      [&](size_t blockIdx) {
+        iterations[blockIdx] = solver.SolveBlock(blocks[blockIdx]);
+      },
+      [&](size_t blockIdx) {
+        auto const blockAssignments = GetBlockAssignments(graph, blocks[blockIdx], solver.GetSolution().matching);
+        PersistAssignments(result, blockAssignments, previous, writers, assignmentNodes, addedAssignments);
+        assignments.insert(assignments.end(), blockAssignments.cbegin(), blockAssignments.cend());
+
+        m_logger.Info("ScheduleBuilderAgent: Block ", blockIdx + 1, " of ", blocks.size(), " solved in ",
+                      iterations[blockIdx], " iterations, ", blockAssignments.size(), " assignments persisted");
+      });
+
+  matching = solver.GetSolution().matching;
+  m_logger.Info("ScheduleBuilderAgent: Matched ", assignments.size(), " of ", graph.slots.size(), " slots");
+}
+
+// ===== Создание результата =====
+
+// Вызывается и из потоков записи, поэтому работает через переданный контекст
+ScAddr ScheduleBuilder::CreateShiftAssignment(
+    ScMemoryContext & context,
+    ScAddr const & employee,
+    ScAddr const & day,
+    ScAddr const & shiftType)
+{
+  ScAddr assignment = context.GenerateNode(ScType::ConstNode);
+  context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_shift_assignment, assignment);
+
+  auto createAssignmentRelation = [&context, assignment](ScAddr const & value, ScAddr const & relation) {
+    ScAddr arc = context.GenerateConnector(ScType::ConstCommonArc, assignment, value);
+    context.GenerateConnector(ScType::ConstPermPosArc, relation, arc);
+  };
+
+  createAssignmentRelation(employee, SchedulingKeynodes::nrel_assigned_to_shift);
+  createAssignmentRelation(day, SchedulingKeynodes::nrel_shift_day);
+  createAssignmentRelation(shiftType, SchedulingKeynodes::nrel_shift_type);
+
+  return assignment;
+}
+
+void ScheduleBuilder::AddWorkloadsToResult(
+    ScStructure & result,
+    std::unordered_map<ScAddr, int, ScAddrHashFunc> const & workloads,
+    PreviousSchedule const & previous,
+    size_t writers,
+    std::vector<ScAddr> & changedWorkloads)
+{
+  auto const started = std::chrono::steady_clock::now();
+
+  // Сотрудники распределяются по шардам по очереди
+  std::vector<std::vector<std::pair<ScAddr, int>>> shards(std::min(writers, std::max<size_t>(workloads.size(), 1)));
+  size_t next = 0;
+  for (auto const & workload : workloads)
+    shards[next++ % shards.size()].push_back(workload);
+
+  std::vector<std::vector<ScAddr>> shardChanged(shards.size());
+  std::vector<size_t> shardElements(shards.size(), 0);
+
+  auto const writeShard = [&](ScMemoryContext & context, size_t shard) {
+    for (auto const & [empAddr, count] : shards[shard])
+    {
+      auto const it = previous.workloads.find(empAddr);
+      if (it != previous.workloads.end() && it->second.count == count)
+      {
+        context.GenerateConnector(ScType::ConstPermPosArc, result, it->second.link);
+        context.GenerateConnector(ScType::ConstPermPosArc, result, it->second.arc);
+        shardElements[shard] += 2;
+        continue;
+      }
+
+      ScAddr countLink = context.GenerateLink(ScType::ConstNodeLink);
+      context.SetLinkContent(countLink, count);
+      ScAddr arcWorkload = context.GenerateConnector(ScType::ConstCommonArc, empAddr, countLink);
+      context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_workload, arcWorkload);
+      context.GenerateConnector(ScType::ConstPermPosArc, result, countLink);
+      context.GenerateConnector(ScType::ConstPermPosArc, result, arcWorkload);
+      shardChanged[shard].push_back(arcWorkload);
+      shardElements[shard] += 6;
+    }
+  };
+
+  if (shards.size() == 1)
+    writeShard(m_context, 0);
+  else
+  {
+    RunShards(shards.size(), [&](size_t shard) {
+      ScAgentContext context;
+      writeShard(context, shard);
+    });
+  }
+
+  for (auto const & changed : shardChanged)
+    changedWorkloads.insert(changedWorkloads.end(), changed.cbegin(), changed.cend());
+
+  LogWriteThroughput(
+      "Workloads persisted", std::accumulate(shardElements.cbegin(), shardElements.cend(), size_t{0}), shards.size(),
+      std::chrono::steady_clock::now() - started);
+}
+
+// Неизменившиеся назначения берём из предыдущего расписания, новые создаём.
+// При нескольких потоках записи каждый шард (группа дней) пишется через собственный контекст
+void ScheduleBuilder::PersistAssignments(
+    ScStructure & result,
+    std::vector<ShiftAssignment> const & assignments,
+    PreviousSchedule const & previous,
+    size_t writers,
+    std::vector<ScAddr> & assignmentNodes,
+    std::vector<ScAddr> & addedAssignments)
+{
+  auto const started = std::chrono::steady_clock::now();
+
+  size_t const offset = assignmentNodes.size();
+  assignmentNodes.resize(offset + assignments.size());
+  std::vector<char> isAdded(assignments.size(), 0);
+
+  auto const shards = GetDayShards(assignments, writers);
+  std::vector<size_t> shardElements(shards.size(), 0);
+
+  auto const writeShard = [&](ScMemoryContext & context, size_t shard) {
+    for (size_t i : shards[shard])
+    {
+      auto const & assignment = assignments[i];
+      ScAddr assignmentNode;
+      auto const it = previous.assignments.find(assignment);
+      if (it != previous.assignments.end())
+        assignmentNode = it->second;
+      else
+      {
+        assignmentNode = CreateShiftAssignment(context, assignment.employee, assignment.day, assignment.shiftType);
+        isAdded[i] = 1;
+        shardElements[shard] += 8;
+      }
+
+      context.GenerateConnector(ScType::ConstPermPosArc, result, assignmentNode);
+      assignmentNodes[offset + i] = assignmentNode;
+      shardElements[shard] += 1;
+    }
+  };
+
+  if (shards.size() <= 1)
+  {
+    if (!shards.empty())
+      writeShard(m_context, 0);
+  }
+  else
+  {
+    RunShards(shards.size(), [&](size_t shard) {
+      ScAgentContext context;
+      writeShard(context, shard);
+    });
+  }
+
+  for (size_t i = 0; i < assignments.size(); ++i)
+  {
+    if (isAdded[i])
+      addedAssignments.push_back(assignmentNodes[offset + i]);
+  }
+
+  LogWriteThroughput(
+      "Assignments persisted", std::accumulate(shardElements.cbegin(), shardElements.cend(), size_t{0}),
+      std::max<size_t>(shards.size(), 1), std::chrono::steady_clock::now() - started);
+}
+
+// В concept_schedule расписание попадает только при публикации, когда оно построено целиком
+void ScheduleBuilder::CompleteScheduleResult(
+    ScStructure & result,
+    std::vector<ShiftAssignment> const & assignments,
+    std::unordered_map<ScAddr, int, ScAddrHashFunc> const & workloads,
+    ScAddr const & bipartiteGraphAddr,
+    PreviousSchedule const & previous,
+    std::vector<ScAddr> const & addedAssignments,
+    size_t writers)
+{
+  if (bipartiteGraphAddr.IsValid())
+    result << bipartiteGraphAddr;
+
+  std::vector<ScAddr> changedWorkloads;
+  AddWorkloadsToResult(result, workloads, previous, writers, changedWorkloads);
+
+  if (previous.addr.IsValid())
+    CreateScheduleDiff(result, previous, assignments, addedAssignments, changedWorkloads);
+}
+
+// ===== Параллельная запись в SC-memory =====
+
+size_t ScheduleBuilder::GetPersistenceWriters(ScAction & action)
+{
+  if (!m_context.CheckConnector(action, SchedulingKeynodes::schedule_parallel_persistence, ScType::ConstPermPosArc))
+    return 1;
+
+  ScAddr writersLink = GetAttribute(
+      SchedulingKeynodes::schedule_parallel_persistence, SchedulingKeynodes::nrel_persistence_writers);
+  int const writers = GetIntFromLink(writersLink, static_cast<int>(DEFAULT_PERSISTENCE_WRITERS));
+  return writers > 0 ? static_cast<size_t>(writers) : DEFAULT_PERSISTENCE_WRITERS;
+}
+
+// Назначения одного дня попадают в один шард; дни распределяются по шардам по очереди
+std::vector<std::vector<size_t>> ScheduleBuilder::GetDayShards(
+    std::vector<ShiftAssignment> const & assignments,
+    size_t writers)
+{
+  std::unordered_map<ScAddr, size_t, ScAddrHashFunc> dayShards;
+  std::vector<std::vector<size_t>> shards;
+  for (size_t i = 0; i < assignments.size(); ++i)
+  {
+    auto const it = dayShards.emplace(assignments[i].day, dayShards.size() % writers).first;
+    if (it->second >= shards.size())
+      shards.resize(it->second + 1);
+    shards[it->second].push_back(i);
+  }
+  return shards;
+}
+
+void ScheduleBuilder::LogWriteThroughput(
+    std::string const & stage,
+    size_t elements,
+    size_t writers,
+    std::chrono::steady_clock::duration elapsed)
+{
+  double const seconds = std::chrono::duration<double>(elapsed).count();
+  double const throughput = seconds > 0 ? elements / seconds : 0;
+  m_logger.Info("ScheduleBuilderAgent: ", stage, ": ", elements, " elements by ", writers, " writers in ",
+                std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count(), " ms (",
+                static_cast<size_t>(throughput), " elements/s)");
+}
+
+// ===== Сохранение изменений относительно предыдущего расписания =====
+
+PreviousSchedule ScheduleBuilder::LoadPreviousSchedule(ScAddr const & schedule)
+{
+  PreviousSchedule previous;
+  previous.addr = schedule;
+
+  ScIterator3Ptr it = m_context.CreateIterator3(schedule, ScType::ConstPermPosArc, ScType::Unknown);
+  while (it->Next())
+  {
+    ScAddr element = it->Get(2);
+
+    if (m_context.CheckConnector(SchedulingKeynodes::concept_shift_assignment, element, ScType::ConstPermPosArc))
+    {
+      ShiftAssignment assignment{
+          GetAttribute(element, SchedulingKeynodes::nrel_shift_day),
+          GetAttribute(element, SchedulingKeynodes::nrel_shift_type),
+          GetAttribute(element, SchedulingKeynodes::nrel_assigned_to_shift)};
+      previous.assignments.emplace(assignment, element);
+      continue;
+    }
+
+    if (!m_context.GetElementType(element).IsLink())
+      continue;
+
+    ScIterator5Ptr itWorkload = m_context.CreateIterator5(
+        ScType::ConstNode, ScType::ConstCommonArc, element, ScType::ConstPermPosArc,
+        SchedulingKeynodes::nrel_workload);
+    if (itWorkload->Next())
+      previous.workloads[itWorkload->Get(0)] = {GetIntFromLink(element, -1), element, itWorkload->Get(1)};
+  }
+
+  return previous;
+}
+
+// Структура изменений: добавленные и исключённые назначения, изменившаяся загруженность
+void ScheduleBuilder::CreateScheduleDiff(
+    ScStructure & result,
+    PreviousSchedule const & previous,
+    std::vector<ShiftAssignment> const & assignments,
+    std::vector<ScAddr> const & addedAssignments,
+    std::vector<ScAddr> const & changedWorkloads)
+{
+  ScStructure diff = m_context.GenerateStructure();
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_schedule_diff, diff);
+
+  auto addDiffElement = [this, &diff](ScAddr const & element, ScAddr const & role) {
+    ScAddr arc = m_context.GenerateConnector(ScType::ConstPermPosArc, diff, element);
+    m_context.GenerateConnector(ScType::ConstPermPosArc, role, arc);
+  };
+
+  for (ScAddr const & assignmentNode : addedAssignments)
+    addDiffElement(assignmentNode, SchedulingKeynodes::rrel_added_assignment);
+
+  std::unordered_set<ShiftAssignment, ShiftAssignmentHash> const current(assignments.begin(), assignments.end());
+  size_t removedCount = 0;
+  for (auto const & [assignment, assignmentNode] : previous.assignments)
+  {
+    if (current.count(assignment) == 0)
+    {
+      addDiffElement(assignmentNode, SchedulingKeynodes::rrel_removed_assignment);
+      removedCount++;
+    }
+  }
+
+  for (ScAddr const & workloadArc : changedWorkloads)
+    addDiffElement(workloadArc, SchedulingKeynodes::rrel_changed_workload);
+
+  ScAddr arcDiff = m_context.GenerateConnector(ScType::ConstCommonArc, result, diff);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_schedule_diff, arcDiff);
+
+  ScAddr arcPrevious = m_context.GenerateConnector(ScType::ConstCommonArc, result, previous.addr);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_previous_schedule, arcPrevious);
+
+  m_logger.Info("ScheduleBuilderAgent: Schedule diff - added: ", addedAssignments.size(), ", removed: ",
+                removedCount, ", changed workloads: ", changedWorkloads.size());
+}
+
+// ===== Индексы составов смен и графиков сотрудников =====
+
+// Для каждой пары (день, смена) создаёт узел-состав, содержащий назначенных сотрудников
+void ScheduleBuilder::AddRosterIndex(
+    ScStructure & result,
+    std::vector<ShiftAssignment> const & assignments,
+    std::vector<ScAddr> const & weekdays,
+    std::vector<ScAddr> const & shiftTypes)
+{
+  std::unordered_map<ScAddr, std::unordered_map<ScAddr, ScAddr, ScAddrHashFunc>, ScAddrHashFunc> rosters;
+
+  auto createRosterRelation = [this](ScAddr const & roster, ScAddr const & value, ScAddr const & relation) {
+    ScAddr arc = m_context.GenerateConnector(ScType::ConstCommonArc, roster, value);
+    m_context.GenerateConnector(ScType::ConstPermPosArc, relation, arc);
+  };
+
+  for (auto const & day : weekdays)
+  {
+    for (auto const & shiftType : shiftTypes)
+    {
+      ScAddr roster = m_context.GenerateNode(ScType::ConstNode);
+      m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_shift_roster, roster);
+      createRosterRelation(roster, day, SchedulingKeynodes::nrel_shift_day);
+      createRosterRelation(roster, shiftType, SchedulingKeynodes::nrel_shift_type);
+      createRosterRelation(result, roster, SchedulingKeynodes::nrel_shift_roster);
+      result << roster;
+      rosters[day][shiftType] = roster;
+    }
+  }
+
+  for (auto const & assignment : assignments)
+  {
+    ScAddr const & roster = rosters[assignment.day][assignment.shiftType];
+    m_context.GenerateConnector(ScType::ConstPermPosArc, roster, assignment.employee);
+  }
+}
+
+// Для каждого сотрудника создаёт узел недельного графика: его назначения и маску смен
+void ScheduleBuilder::AddTimetableIndex(
+    ScStructure & result,
+    BipartiteGraph const & graph,
+    std::vector<ShiftAssignment> const & assignments,
+    std::vector<ScAddr> const & assignmentNodes,
+    std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc> const & shiftMasks)
+{
+  std::unordered_map<ScAddr, ScAddr, ScAddrHashFunc> timetables;
+  for (auto const & emp : graph.employees)
+  {
+    ScAddr timetable = m_context.GenerateNode(ScType::ConstNode);
+    m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_employee_timetable, timetable);
+
+    ScAddr arcEmployee = m_context.GenerateConnector(ScType::ConstCommonArc, timetable, emp.addr);
+    m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_timetable_employee, arcEmployee);
+
+    auto const it = shiftMasks.find(emp.addr);
+    ScAddr maskLink = m_context.GenerateLink(ScType::ConstNodeLink);
+    m_context.SetLinkContent(maskLink, std::to_string(it != shiftMasks.end() ? it->second : 0));
+    ScAddr arcMask = m_context.GenerateConnector(ScType::ConstCommonArc, timetable, maskLink);
+    m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_shift_mask, arcMask);
+
+    result << timetable << maskLink;
+    timetables[emp.addr] = timetable;
+  }
+
+  for (size_t i = 0; i < assignments.size(); ++i)
+    m_context.GenerateConnector(ScType::ConstPermPosArc, timetables[assignments[i].employee], assignmentNodes[i]);
+}
+
+// ===== Компактное представление расписания =====
+
+// Маска смен сотрудника: бит dayIndex * shiftsCount + shiftIndex
+std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc> ScheduleBuilder::GetShiftMasks(
+    std::vector<ShiftAssignment> const & assignments,
+    std::vector<ScAddr> const & weekdays,
+    std::vector<ScAddr> const & shiftTypes)
+{
+  std::unordered_map<ScAddr, size_t, ScAddrHashFunc> dayIndices;
+  for (size_t i = 0; i < weekdays.size(); ++i)
+    dayIndices[weekdays[i]] = i;
+
+  std::unordered_map<ScAddr, size_t, ScAddrHashFunc> shiftIndices;
+  for (size_t i = 0; i < shiftTypes.size(); ++i)
+    shiftIndices[shiftTypes[i]] = i;
+
+  std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc> masks;
+  for (auto const & assignment : assignments)
+  {
+    masks[assignment.employee] |= ScheduleEncoding::GetShiftBit(
+        dayIndices.at(assignment.day), shiftIndices.at(assignment.shiftType), shiftTypes.size());
+  }
+  return masks;
+}
+
+void ScheduleBuilder::AddScheduleEncoding(
+    ScStructure & result,
+    BipartiteGraph const & graph,
+    std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc> const & shiftMasks,
+    std::vector<ScAddr> const & weekdays,
+    std::vector<ScAddr> const & shiftTypes)
+{
+  EncodedSchedule encoded;
+  encoded.daysCount = weekdays.size();
+  encoded.shiftsCount = shiftTypes.size();
+  encoded.employeeIds.reserve(graph.employees.size());
+  encoded.shiftMasks.reserve(graph.employees.size());
+  for (auto const & emp : graph.employees)
+  {
+    auto const it = shiftMasks.find(emp.addr);
+    encoded.employeeIds.push_back(emp.addr.Hash());
+    encoded.shiftMasks.push_back(it != shiftMasks.end() ? it->second : 0);
+  }
+
+  std::string const content = ScheduleEncoding::Encode(encoded);
+  ScAddr encodingLink = m_context.GenerateLink(ScType::ConstNodeLink);
+  m_context.SetLinkContent(encodingLink, content);
+  ScAddr arcEncoding = m_context.GenerateConnector(ScType::ConstCommonArc, result, encodingLink);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_schedule_encoding, arcEncoding);
+  result << encodingLink;
+
+  m_logger.Info("ScheduleBuilderAgent: Schedule encoded into ", content.size(), " bytes");
+}
+
+// ===== История расписаний =====
+
+// Возвращает расписания, построенные по данным требованиям, с их версиями
+std::vector<std::pair<int, ScAddr>> ScheduleBuilder::GetStoredSchedules(ScAddr const & requirementsAddr)
+{
+  std::vector<std::pair<int, ScAddr>> schedules;
+
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      ScType::ConstNodeStructure, ScType::ConstCommonArc, requirementsAddr, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_schedule_requirements);
+  while (it->Next())
+  {
+    ScAddr schedule = it->Get(0);
+    ScIterator5Ptr itVersion = m_context.CreateIterator5(
+        schedule, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc,
+        SchedulingKeynodes::nrel_schedule_version);
+    int version = itVersion->Next() ? GetIntFromLink(itVersion->Get(2), 0) : 0;
+    schedules.emplace_back(version, schedule);
+  }
+
+  return schedules;
+}
+
+ScAddr ScheduleBuilder::GetLatestSchedule(ScAddr const & requirementsAddr)
+{
+  int latestVersion = 0;
+  ScAddr latestSchedule;
+  for (auto const & [version, schedule] : GetStoredSchedules(requirementsAddr))
+  {
+    if (!latestSchedule.IsValid() || version > latestVersion)
+    {
+      latestVersion = version;
+      latestSchedule = schedule;
+    }
+  }
+  return latestSchedule;
+}
+
+void ScheduleBuilder::AddScheduleToHistory(ScAddr const & schedule, ScAddr const & requirementsAddr)
+{
+  int lastVersion = 0;
+  for (auto const & [version, storedSchedule] : GetStoredSchedules(requirementsAddr))
+    lastVersion = std::max(lastVersion, version);
+
+  ScAddr arcRequirements = m_context.GenerateConnector(ScType::ConstCommonArc, schedule, requirementsAddr);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_schedule_requirements, arcRequirements);
+
+  ScAddr versionLink = m_context.GenerateLink(ScType::ConstNodeLink);
+  m_context.SetLinkContent(versionLink, std::to_string(lastVersion + 1));
+  ScAddr arcVersion = m_context.GenerateConnector(ScType::ConstCommonArc, schedule, versionLink);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_schedule_version, arcVersion);
+}
+
+// Оставляет только maxStoredSchedules последних расписаний по данным требованиям
+void ScheduleBuilder::EraseSupersededSchedules(ScAddr const & requirementsAddr, int maxStoredSchedules)
+{
+  if (maxStoredSchedules <= 0)
+    return;
+
+  auto schedules = GetStoredSchedules(requirementsAddr);
+  if (schedules.size() <= static_cast<size_t>(maxStoredSchedules))
+    return;
+
+  std::sort(schedules.begin(), schedules.end(), [](auto const & a, auto const & b) {
+    return a.first > b.first;
+  });
+
+  std::vector<ScAddr> superseded;
+  for (size_t i = maxStoredSchedules; i < schedules.size(); ++i)
+    superseded.push_back(schedules[i].second);
+
+  ScheduleCollector collector(m_context);
+  size_t erasedCount = collector.Erase(superseded);
+
+  m_logger.Info("ScheduleBuilderAgent: Erased ", superseded.size(), " superseded schedules (", erasedCount,
+                " elements)");
+}
+
+// ===== Повторное использование расписания по отпечатку входных данных =====
+
+// Отпечаток учитывает штат (сотрудники, профессии, разрешённые и запрещённые смены), узел требований
+// и их значения, дни недели, типы смен и параметры, влияющие на сохраняемый результат. Узел требований
+// входит в отпечаток, потому что расписание попадает в историю только своего узла
+std::string ScheduleBuilder::ComputeInputFingerprint(
+    ScAction & action,
+    ShiftRequirements const & reqs,
+    BipartiteGraph const & graph,
+    std::vector<ScAddr> const & weekdays,
+    std::vector<ScAddr> const & shiftTypes)
+{
+  auto const sortedHashes = [](ScAddrUnorderedSet const & set) {
+    std::vector<uint64_t> hashes;
+    hashes.reserve(set.size());
+    for (ScAddr const & addr : set)
+      hashes.push_back(addr.Hash());
+    std::sort(hashes.begin(), hashes.end());
+    return hashes;
+  };
+
+  std::vector<Employee const *> employees;
+  employees.reserve(graph.employees.size());
+  for (Employee const & emp : graph.employees)
+    employees.push_back(&emp);
+  std::sort(employees.begin(), employees.end(), [](Employee const * a, Employee const * b) {
+    return a->addr.Hash() < b->addr.Hash();
+  });
+
+  InputFingerprint fingerprint;
+  fingerprint.Add(static_cast<uint64_t>(employees.size()));
+  for (Employee const * emp : employees)
+  {
+    fingerprint.Add(emp->addr.Hash());
+    fingerprint.Add(emp->profession.Hash());
+    for (auto const & shifts : {sortedHashes(emp->allowedShifts), sortedHashes(emp->forbiddenShifts)})
+    {
+      fingerprint.Add(static_cast<uint64_t>(shifts.size()));
+      for (uint64_t hash : shifts)
+        fingerprint.Add(hash);
+    }
+  }
+
+  auto const & [requirementsAddr] = action.GetArguments<1>();
+  fingerprint.Add(requirementsAddr.Hash());
+
+  fingerprint.Add(static_cast<uint64_t>(reqs.professionCounts.size()));
+  for (auto const & [profession, count] : reqs.professionCounts)
+  {
+    fingerprint.Add(profession.Hash());
+    fingerprint.Add(static_cast<uint64_t>(count));
+  }
+
+  for (int value : {reqs.maxShiftsPerWeek, reqs.maxStoredSchedules})
+    fingerprint.Add(static_cast<uint64_t>(value));
+
+  for (auto const * addrs : {&weekdays, &shiftTypes})
+  {
+    fingerprint.Add(static_cast<uint64_t>(addrs->size()));
+    for (ScAddr const & addr : *addrs)
+      fingerprint.Add(addr.Hash());
+  }
+
+  std::vector<ScAddr> const options = {
+      SchedulingKeynodes::graph_persistence_none,
+      SchedulingKeynodes::graph_persistence_matched_edges,
+      SchedulingKeynodes::graph_persistence_full,
+      SchedulingKeynodes::schedule_persistence_diff,
+      SchedulingKeynodes::schedule_encoding_binary};
+  for (ScAddr const & option : options)
+    fingerprint.Add(static_cast<uint64_t>(m_context.CheckConnector(action, option, ScType::ConstPermPosArc)));
+
+  return "schedule-input:" + fingerprint.ToString();
+}
+
+// Подходит только опубликованное расписание из истории тех же требований: иначе оно не учитывается
+// политикой хранения этого узла и может быть удалено при очистке истории другого
+ScAddr ScheduleBuilder::FindScheduleByFingerprint(std::string const & fingerprint, ScAddr const & requirementsAddr)
+{
+  for (ScAddr const & link : m_context.SearchLinksByContent(fingerprint))
+  {
+    ScIterator5Ptr it = m_context.CreateIterator5(
+        ScType::ConstNodeStructure, ScType::ConstCommonArc, link, ScType::ConstPermPosArc,
+        SchedulingKeynodes::nrel_input_fingerprint);
+    while (it->Next())
+    {
+      ScAddr schedule = it->Get(0);
+      if (!m_context.CheckConnector(SchedulingKeynodes::concept_schedule, schedule, ScType::ConstPermPosArc))
+        continue;
+      if (requirementsAddr.IsValid() && !IsInHistory(schedule, requirementsAddr))
+        continue;
+      return schedule;
+    }
+  }
+  return ScAddr::Empty;
+}
+
+bool ScheduleBuilder::IsInHistory(ScAddr const & schedule, ScAddr const & requirementsAddr)
+{
+  ScIterator5Ptr it = m_context.CreateIterator5(
+      schedule, ScType::ConstCommonArc, requirementsAddr, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_schedule_requirements);
+  return it->Next();
+}
+
+void ScheduleBuilder::AddInputFingerprint(ScAddr const & schedule, std::string const & fingerprint)
+{
+  ScAddr fingerprintLink = m_context.GenerateLink(ScType::ConstNodeLink);
+  m_context.SetLinkContent(fingerprintLink, fingerprint);
+  ScAddr arc = m_context.GenerateConnector(ScType::ConstCommonArc, schedule, fingerprintLink);
+  m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::nrel_input_fingerprint, arc);
+}
+
+// ===== Публикация расписания =====
+
+// Расписание становится видимым читателям целиком: членство в concept_schedule добавляется после
+// всех назначений и индексов, затем переключается current_schedule. Новая дуга создаётся раньше,
+// чем удаляется старая, поэтому читатель всегда находит полностью построенное расписание
+void ScheduleBuilder::PublishSchedule(ScAddr const & schedule)
+{
+  if (!m_context.CheckConnector(SchedulingKeynodes::concept_schedule, schedule, ScType::ConstPermPosArc))
+    m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::concept_schedule, schedule);
+
+  bool isCurrent = false;
+  std::vector<ScAddr> staleArcs;
+  ScIterator3Ptr it = m_context.CreateIterator3(
+      SchedulingKeynodes::current_schedule, ScType::ConstPermPosArc, ScType::ConstNodeStructure);
+  while (it->Next())
+  {
+    if (it->Get(2) == schedule)
+      isCurrent = true;
+    else
+      staleArcs.push_back(it->Get(1));
+  }
+
+  if (!isCurrent)
+    m_context.GenerateConnector(ScType::ConstPermPosArc, SchedulingKeynodes::current_schedule, schedule);
+
+  for (ScAddr const & arc : staleArcs)
+    m_context.EraseElement(arc);
+}
+
+// ===== Основная логика построения =====
+
+void ScheduleBuilder::LogRequirements(ShiftRequirements const & reqs)
+{
+  for (auto const & [profession, count] : reqs.professionCounts)
+  {
+    m_logger.Info("ScheduleBuilderAgent: Requirements - ", m_context.GetElementSystemIdentifier(profession), ": ",
+                  count);
+  }
+  m_logger.Info("ScheduleBuilderAgent: Requirements - max shifts/week: ", reqs.maxShiftsPerWeek);
+}
+
+std::vector<ShiftAssignment> ScheduleBuilder::GetBlockAssignments(
+    BipartiteGraph const & graph,
+    ScheduleBlock const & block,
+    std::vector<int> const & matching)
+{
+  std::vector<ShiftAssignment> assignments;
+  for (int slotIdx : block.slots)
+  {
+    int empIdx = matching[slotIdx];
+    if (empIdx != -1)
+    {
+      auto const & slot = graph.slots[slotIdx];
+      assignments.push_back({slot.day, slot.shiftType, graph.employees[empIdx].addr});
+    }
+  }
+  return assignments;
+}
+
+std::unordered_map<ScAddr, int, ScAddrHashFunc> ScheduleBuilder::GetWorkloads(
+    BipartiteGraph const & graph,
+    std::vector<ShiftAssignment> const & assignments)
+{
+  std::unordered_map<ScAddr, int, ScAddrHashFunc> workloads;
+  for (auto const & emp : graph.employees)
+    workloads[emp.addr] = 0;
+
+  for (auto const & assignment : assignments)
+    workloads[assignment.employee]++;
+
+  return workloads;
+}
+
+void ScheduleBuilder::LogWeeklySchedule(
+    BipartiteGraph const & graph,
+    std::vector<ShiftAssignment> const & assignments,
+    std::unordered_map<ScAddr, int, ScAddrHashFunc> const & workloads,
+    std::vector<ScAddr> const & weekdays)
+{
+  m_logger.Info("ScheduleBuilderAgent: === Weekly schedule per employee ===");
+  for (auto const & emp : graph.employees)
+  {
+    std::string schedule = emp.name + ": ";
+    for (auto const & day : weekdays)
+    {
+      bool hasShift = std::any_of(assignments.begin(), assignments.end(),
+                                  [&emp, &day](ShiftAssignment const & a) {
+                                    return a.employee == emp.addr && a.day == day;
+                                  });
+      schedule += hasShift ? "W " : "- ";
+    }
+    schedule += "| Total: " + std::to_string(workloads.at(emp.addr)) + " shifts";
+    m_logger.Info(schedule);
+  }
+}
+
+// Загрузка, решение и сохранение; возвращает расписание или пустой адрес при ошибке
+ScAddr ScheduleBuilder::Build(ScAction & action)
+{
+  bool isAttached = false;
+  return BuildSchedule(action, {}, isAttached);
+}
+
+bool ScheduleBuilder::BuildOrAttach(ScAction & action, InFlightBuildHandler handler, ScAddr & schedule)
+{
+  bool isAttached = false;
+  schedule = BuildSchedule(action, handler, isAttached);
+  return !isAttached;
+}
+
+ScAddr ScheduleBuilder::BuildSchedule(ScAction & action, InFlightBuildHandler const & handler, bool & isAttached)
+{
+  m_logger.Info("ScheduleBuilderAgent: Starting schedule building with bipartite matching");
+
+  ShiftRequirements reqs = GetShiftRequirements(action);
+  LogRequirements(reqs);
+
+  GraphPersistenceLevel graphPersistenceLevel = GetGraphPersistenceLevel(action);
+
+  auto weekdays = GetWeekdays();
+  auto shiftTypes = GetShiftTypes();
+
+  BipartiteGraph graph = BuildBipartiteGraph(reqs, weekdays, shiftTypes);
+
+  if (graph.employees.empty())
+  {
+    m_logger.Error("ScheduleBuilderAgent: No employees found");
+    return ScAddr::Empty;
+  }
+
+  if (graph.slots.empty())
+  {
+    m_logger.Error("ScheduleBuilderAgent: No shift slots to fill");
+    return ScAddr::Empty;
+  }
+
+  std::string const fingerprint = ComputeInputFingerprint(action, reqs, graph, weekdays, shiftTypes);
+
+  // Такое же построение уже выполняется — берём его результат вместо повторного решения
+  auto ticket = GetInFlightBuilds().Acquire(fingerprint);
+  if (!ticket.isOwner)
+  {
+    if (handler && GetInFlightBuilds().AddContinuation(fingerprint, handler))
+    {
+      m_logger.Info("ScheduleBuilderAgent: Identical build in progress, attached to its completion");
+      isAttached = true;
+      return ScAddr::Empty;
+    }
+
+    // Долгое ожидание остаётся асинхронным заданиям: они присоединяются выше. Синхронный запрос
+    // занимает поток обработки событий, поэтому ждёт недолго — только почти завершённое построение.
+    // Если присоединиться не удалось, построение уже завершилось и результат готов без ожидания
+    m_logger.Info("ScheduleBuilderAgent: Identical build in progress, waiting for its result");
+    if (ticket.result.wait_for(IN_FLIGHT_SYNC_WAIT_TIMEOUT) == std::future_status::ready)
+      return ticket.result.get();
+
+    m_logger.Warning(
+        "ScheduleBuilderAgent: Identical build not finished in ", IN_FLIGHT_SYNC_WAIT_TIMEOUT.count(),
+        " ms, building independently");
+  }
+  InFlightBuildGuard inFlightBuild(fingerprint, ticket.isOwner);
+
+  auto const & [requirementsAddr] = action.GetArguments<1>();
+
+  // Входные данные не изменились — возвращаем уже сохранённое расписание без повторного решения
+  if (!m_context.CheckConnector(action, SchedulingKeynodes::schedule_rebuild_forced, ScType::ConstPermPosArc))
+  {
+    ScAddr storedSchedule = FindScheduleByFingerprint(fingerprint, requirementsAddr);
+    if (storedSchedule.IsValid())
+    {
+      m_logger.Info("ScheduleBuilderAgent: Input unchanged, returning stored schedule");
+      PublishSchedule(storedSchedule);
+      inFlightBuild.result = storedSchedule;
+      return storedSchedule;
+    }
+  }
+
+  // В режиме сохранения изменений сравниваем с последним расписанием по тем же требованиям
+  PreviousSchedule previous;
+  if (requirementsAddr.IsValid() &&
+      m_context.CheckConnector(action, SchedulingKeynodes::schedule_persistence_diff, ScType::ConstPermPosArc))
+  {
+    ScAddr latestSchedule = GetLatestSchedule(requirementsAddr);
+    if (latestSchedule.IsValid())
+      previous = LoadPreviousSchedule(latestSchedule);
+  }
+
+  // Решение и запись назначений идут конвейером по профессиям
+  size_t const writers = GetPersistenceWriters(action);
+  ScStructure result = m_context.GenerateStructure();
+  std::vector<int> matching;
+  std::vector<ShiftAssignment> assignments;
+  std::vector<ScAddr> assignmentNodes;
+  std::vector<ScAddr> addedAssignments;
+  SolveAndPersistAssignments(
+      graph, previous, writers, result, matching, assignments, assignmentNodes, addedAssignments);
+
+  // Граф сохраняется с учётом всего паросочетания (только рёбра из matching)
+  ScAddr graphAddr = SaveBipartiteGraphToScMemory(graph, matching, graphPersistenceLevel);
+
+  auto const workloads = GetWorkloads(graph, assignments);
+
+  int totalSlots = graph.slots.size();
+  int filledSlots = assignments.size();
+  bool scheduleComplete = (filledSlots == totalSlots);
+
+  m_logger.Info("ScheduleBuilderAgent: Filled ", filledSlots, " of ", totalSlots, " slots");
+  m_logger.Info("ScheduleBuilderAgent: Schedule complete: ",
+                scheduleComplete ? "YES" : "NO (some shifts unfilled)");
+
+  LogWeeklySchedule(graph, assignments, workloads, weekdays);
+
+  CompleteScheduleResult(result, assignments, workloads, graphAddr, previous, addedAssignments, writers);
+  AddRosterIndex(result, assignments, weekdays, shiftTypes);
+
+  auto const shiftMasks = GetShiftMasks(assignments, weekdays, shiftTypes);
+  AddTimetableIndex(result, graph, assignments, assignmentNodes, shiftMasks);
+
+  if (m_context.CheckConnector(action, SchedulingKeynodes::schedule_encoding_binary, ScType::ConstPermPosArc))
+    AddScheduleEncoding(result, graph, shiftMasks, weekdays, shiftTypes);
+
+  AddInputFingerprint(result, fingerprint);
+
+  if (requirementsAddr.IsValid())
+    AddScheduleToHistory(result, requirementsAddr);
+
+  PublishSchedule(result);
+
+  // Старые расписания удаляются только после того, как читатели переключены на новое
+  if (requirementsAddr.IsValid())
+    EraseSupersededSchedules(requirementsAddr, reqs.maxStoredSchedules);
+
+  m_logger.Info("ScheduleBuilderAgent: Created ", assignments.size(), " shift assignments");
+
+  inFlightBuild.result = result;
+  return result;
+}
@@ -0,0 +1,351 @@
+#pragma once
+
+#include <sc-memory/sc_agent.hpp>
+#include "solver/scheduleProblem.hpp"
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+// Структура для хранения информации о сотруднике
+struct Employee
+{
+  ScAddr addr;
+  std::string name;
+  ScAddr profession;
+  ScAddrUnorderedSet allowedShifts;
+  ScAddrUnorderedSet forbiddenShifts;
+  int assignedCount = 0;
+  int index = -1;  // Индекс в левой доле графа
+};
+
+// Структура для хранения слота смены (день + тип смены + позиция)
+struct ShiftSlot
+{
+  ScAddr day;
+  ScAddr shiftType;
+  ScAddr profession;  // Какая профессия нужна для этого слота
+  int position;       // Позиция в смене (0, 1, ... для нескольких сотрудников одной профессии)
+  int index = -1;     // Индекс в правой доле графа
+  ScAddr scAddr;      // Адрес узла слота в SC-memory
+};
+
+// Координаты слота смены, по которым слоты переиспользуются между построениями
+struct ShiftSlotKey
+{
+  ScAddr day;
+  ScAddr shiftType;
+  ScAddr profession;
+  int position;
+
+  bool operator==(ShiftSlotKey const & other) const
+  {
+    return day == other.day && shiftType == other.shiftType && profession == other.profession &&
+           position == other.position;
+  }
+};
+
+struct ShiftSlotKeyHash
+{
+  size_t operator()(ShiftSlotKey const & key) const
+  {
+    size_t hash = ScAddrHashFunc()(key.day);
+    hash = hash * 31 + ScAddrHashFunc()(key.shiftType);
+    hash = hash * 31 + ScAddrHashFunc()(key.profession);
+    return hash * 31 + std::hash<int>()(key.position);
+  }
+};
+
+// Реестр узлов слотов в SC-memory: координаты слота -> узел слота
+using ShiftSlotRegistry = std::unordered_map<ShiftSlotKey, ScAddr, ShiftSlotKeyHash>;
+
+// Структура для хранения назначения на смену
+struct ShiftAssignment
+{
+  ScAddr day;
+  ScAddr shiftType;
+  ScAddr employee;
+
+  bool operator==(ShiftAssignment const & other) const
+  {
+    return day == other.day && shiftType == other.shiftType && employee == other.employee;
+  }
+};
+
+struct ShiftAssignmentHash
+{
+  size_t operator()(ShiftAssignment const & assignment) const
+  {
+    size_t hash = ScAddrHashFunc()(assignment.day);
+    hash = hash * 31 + ScAddrHashFunc()(assignment.shiftType);
+    return hash * 31 + ScAddrHashFunc()(assignment.employee);
+  }
+};
+
+// Запись о загруженности сотрудника в SC-memory
+struct StoredWorkload
+{
+  int count = 0;
+  ScAddr link;
+  ScAddr arc;
+};
+
+// Ранее сохранённое расписание, относительно которого записываются изменения
+struct PreviousSchedule
+{
+  ScAddr addr;
+  std::unordered_map<ShiftAssignment, ScAddr, ShiftAssignmentHash> assignments;
+  std::unordered_map<ScAddr, StoredWorkload, ScAddrHashFunc> workloads;
+};
+
+// Структура для хранения требований к составу смены
+struct ShiftRequirements
+{
+  // Профессии из кодовой таблицы и число сотрудников каждой на смену, в порядке таблицы
+  std::vector<std::pair<ScAddr, int>> professionCounts;
+  int maxShiftsPerWeek = 5;
+  int maxStoredSchedules = 0;  // Сколько последних расписаний хранить (0 — без ограничения)
+};
+
+// Уровень сохранения двудольного графа в SC-memory
+enum class GraphPersistenceLevel
+{
+  None,          // Граф не сохраняется
+  MatchedEdges,  // Только слоты и сотрудники из паросочетания и рёбра между ними
+  Full           // Все слоты и сотрудники, рёбра из паросочетания
+};
+
+// Структура двудольного графа для паросочетания
+struct BipartiteGraph
+{
+  std::vector<Employee> employees;                    // Левая доля (сотрудники)
+  std::vector<ShiftSlot> slots;                       // Правая доля (слоты смен)
+  ScheduleProblem problem;                            // Та же задача в плотных индексах для решателя
+  ScAddr graphAddr;                                   // Адрес структуры графа в SC-memory
+};
+
+// Построение недельного расписания: загрузка штата и требований, решение и сохранение результата.
+// Не зависит от агента, поэтому асинхронные построения выполняются в пуле без создания агентов
+class ScheduleBuilder
+{
+public:
+  // Получает результат такого же построения, которое уже выполняется по другому запросу
+  using InFlightBuildHandler = std::function<void(ScAddr const & schedule)>;
+
+  // Сколько синхронный запрос ждёт такое же выполняющееся построение, прежде чем построить расписание сам.
+  // Ожидание короткое: синхронный запрос занимает поток обработки событий
+  static constexpr std::chrono::milliseconds IN_FLIGHT_SYNC_WAIT_TIMEOUT{500};
+
+  ScheduleBuilder(ScAgentContext & context, utils::ScLogger & logger);
+
+  ScAddr Build(ScAction & action);
+
+  // Для построений на пуле: если такое же построение уже выполняется, поток его не ждёт —
+  // результат будет передан handler, а метод вернёт false. Иначе строит расписание сам
+  bool BuildOrAttach(ScAction & action, InFlightBuildHandler handler, ScAddr & schedule);
+
+private:
+  ScAgentContext & m_context;
+  utils::ScLogger & m_logger;
+
+  ScAddr BuildSchedule(ScAction & action, InFlightBuildHandler const & handler, bool & isAttached);
+
+  // ===== Вспомогательные методы для работы с данными =====
+  
+  std::vector<ScAddr> GetWeekdays();
+  std::vector<ScAddr> GetShiftTypes();
+  std::string GetEmployeeName(ScAddr const & employee);
+  int GetIntFromLink(ScAddr const & link, int defaultValue);
+  static int GetDefaultRequiredCount(ScAddr const & profession);
+  int GetRequiredCount(ScAddr const & profession, int defaultValue);
+  ScAddrUnorderedSet GetEmployeeShifts(ScAddr const & employee, ScAddr const & relation);
+  
+  // ===== Работа с требованиями =====
+  
+  ShiftRequirements GetShiftRequirements(ScAction & action);
+  GraphPersistenceLevel GetGraphPersistenceLevel(ScAction & action);
+  
+  // ===== Работа с сотрудниками =====
+  
+  std::vector<Employee> GetEmployeesByProfession(ScAddr const & profession);
+  bool CanWorkShift(Employee const & emp, ScAddr const & shiftType);
+  
+  // ===== Построение двудольного графа =====
+  
+  BipartiteGraph BuildBipartiteGraph(
+      ShiftRequirements const & reqs,
+      std::vector<ScAddr> const & weekdays,
+      std::vector<ScAddr> const & shiftTypes);
+  
+  void BuildEmployeesPart(
+      BipartiteGraph & graph,
+      std::vector<std::pair<ScAddr, int>> const & professionRequirements);
+  
+  void BuildSlotsPart(
+      BipartiteGraph & graph,
+      std::vector<std::pair<ScAddr, int>> const & professionRequirements,
+      std::vector<ScAddr> const & weekdays,
+      std::vector<ScAddr> const & shiftTypes);
+  
+  void BuildSchedulingProblem(
+      BipartiteGraph & graph,
+      std::vector<std::pair<ScAddr, int>> const & professionRequirements,
+      std::vector<ScAddr> const & weekdays,
+      std::vector<ScAddr> const & shiftTypes,
+      int maxShiftsPerWeek);
+  
+  // ===== Сохранение графа в SC-memory =====
+  
+  ScAddr SaveBipartiteGraphToScMemory(
+      BipartiteGraph const & graph,
+      std::vector<int> const & matching,
+      GraphPersistenceLevel level);
+  ScAddr CreateGraphNode();
+  ScAddr CreateGraphPart(ScAddr const & graphNode, ScAddr const & relation);
+  void AddEmployeesToPart(ScAddr const & leftPart, std::vector<Employee> const & employees);
+  ShiftSlotRegistry LoadSlotRegistry(std::vector<ShiftSlot> const & slots);
+  ScAddr GetAttribute(ScAddr const & element, ScAddr const & relation);
+  ScAddr GetOrCreateSlotNode(ShiftSlotRegistry & registry, ShiftSlot const & slot);
+  ScAddr CreateSlotNode(ShiftSlot const & slot);
+  void CreateGraphEdgesInMemory(
+      ScAddr const & graphNode,
+      std::vector<Employee> const & employees,
+      std::vector<ShiftSlot> const & slots,
+      std::vector<int> const & matching,
+      std::vector<ScAddr> const & slotAddrs);
+  
+  // ===== Решение задачи (scheduling-core) =====
+  
+  void SolveAndPersistAssignments(
+      BipartiteGraph const & graph,
+      PreviousSchedule const & previous,
+      size_t writers,
+      ScStructure & result,
+      std::vector<int> & matching,
+      std::vector<ShiftAssignment> & assignments,
+      std::vector<ScAddr> & assignmentNodes,
+      std::vector<ScAddr> & addedAssignments);
+  
+  // ===== Создание результата =====
+  
+  ScAddr CreateShiftAssignment(
+      ScMemoryContext & context,
+      ScAddr const & employee,
+      ScAddr const & day,
+      ScAddr const & shiftType);
+  
+  void PersistAssignments(
+      ScStructure & result,
+      std::vector<ShiftAssignment> const & assignments,
+      PreviousSchedule const & previous,
+      size_t writers,
+      std::vector<ScAddr> & assignmentNodes,
+      std::vector<ScAddr> & addedAssignments);
+  
+  void CompleteScheduleResult(
+      ScStructure & result,
+      std::vector<ShiftAssignment> const & assignments,
+      std::unordered_map<ScAddr, int, ScAddrHashFunc> const & workloads,
+      ScAddr const & bipartiteGraphAddr,
+      PreviousSchedule const & previous,
+      std::vector<ScAddr> const & addedAssignments,
+      size_t writers);
+  
+  void AddWorkloadsToResult(
+      ScStructure & result,
+      std::unordered_map<ScAddr, int, ScAddrHashFunc> const & workloads,
+      PreviousSchedule const & previous,
+      size_t writers,
+      std::vector<ScAddr> & changedWorkloads);
+  
+  // ===== Параллельная запись в SC-memory =====
+  
+  static constexpr size_t DEFAULT_PERSISTENCE_WRITERS = 4;
+  
+  size_t GetPersistenceWriters(ScAction & action);
+  std::vector<std::vector<size_t>> GetDayShards(std::vector<ShiftAssignment> const & assignments, size_t writers);
+  void LogWriteThroughput(
+      std::string const & stage,
+      size_t elements,
+      size_t writers,
+      std::chrono::steady_clock::duration elapsed);
+  
+  // ===== Сохранение изменений относительно предыдущего расписания =====
+  
+  PreviousSchedule LoadPreviousSchedule(ScAddr const & schedule);
+  void CreateScheduleDiff(
+      ScStructure & result,
+      PreviousSchedule const & previous,
+      std::vector<ShiftAssignment> const & assignments,
+      std::vector<ScAddr> const & addedAssignments,
+      std::vector<ScAddr> const & changedWorkloads);
+  
+  // ===== Индексы составов смен и графиков сотрудников =====
+  
+  void AddRosterIndex(
+      ScStructure & result,
+      std::vector<ShiftAssignment> const & assignments,
+      std::vector<ScAddr> const & weekdays,
+      std::vector<ScAddr> const & shiftTypes);
+  
+  void AddTimetableIndex(
+      ScStructure & result,
+      BipartiteGraph const & graph,
+      std::vector<ShiftAssignment> const & assignments,
+      std::vector<ScAddr> const & assignmentNodes,
+      std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc> const & shiftMasks);
+  
+  // ===== Компактное представление расписания =====
+  
+  std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc> GetShiftMasks(
+      std::vector<ShiftAssignment> const & assignments,
+      std::vector<ScAddr> const & weekdays,
+      std::vector<ScAddr> const & shiftTypes);
+  void AddScheduleEncoding(
+      ScStructure & result,
+      BipartiteGraph const & graph,
+      std::unordered_map<ScAddr, uint32_t, ScAddrHashFunc> const & shiftMasks,
+      std::vector<ScAddr> const & weekdays,
+      std::vector<ScAddr> const & shiftTypes);
+  
+  // ===== История расписаний =====
+  
+  std::vector<std::pair<int, ScAddr>> GetStoredSchedules(ScAddr const & requirementsAddr);
+  ScAddr GetLatestSchedule(ScAddr const & requirementsAddr);
+  void AddScheduleToHistory(ScAddr const & schedule, ScAddr const & requirementsAddr);
+  void EraseSupersededSchedules(ScAddr const & requirementsAddr, int maxStoredSchedules);
+  
+  // ===== Повторное использование расписания по отпечатку входных данных =====
+  
+  std::string ComputeInputFingerprint(
+      ScAction & action,
+      ShiftRequirements const & reqs,
+      BipartiteGraph const & graph,
+      std::vector<ScAddr> const & weekdays,
+      std::vector<ScAddr> const & shiftTypes);
+  ScAddr FindScheduleByFingerprint(std::string const & fingerprint, ScAddr const & requirementsAddr);
+  bool IsInHistory(ScAddr const & schedule, ScAddr const & requirementsAddr);
+  void AddInputFingerprint(ScAddr const & schedule, std::string const & fingerprint);
+  
+  // ===== Публикация расписания =====
+  
+  void PublishSchedule(ScAddr const & schedule);
+  
+  // ===== Вспомогательные методы построения =====
+  
+  void LogRequirements(ShiftRequirements const & reqs);
+  std::vector<ShiftAssignment> GetBlockAssignments(
+      BipartiteGraph const & graph,
+      ScheduleBlock const & block,
+      std::vector<int> const & matching);
+  std::unordered_map<ScAddr, int, ScAddrHashFunc> GetWorkloads(
+      BipartiteGraph const & graph,
+      std::vector<ShiftAssignment> const & assignments);
+  void LogWeeklySchedule(
+      BipartiteGraph const & graph,
+      std::vector<ShiftAssignment> const & assignments,
+      std::unordered_map<ScAddr, int, ScAddrHashFunc> const & workloads,
+      std::vector<ScAddr> const & weekdays);
+};
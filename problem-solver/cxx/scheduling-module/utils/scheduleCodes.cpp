@@ -0,0 +1,149 @@
+#include "scheduleCodes.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+
+#include <algorithm>
+#include <tuple>
+#include <unordered_set>
+
+ScheduleCodes::CodeMap::CodeMap(std::vector<Entry> entries)
+{
+  for (auto const & [code, classAddr] : entries)
+  {
+    if (m_canonicalCodes.emplace(classAddr, code).second)
+      m_classOrder.push_back(classAddr);
+  }
+  m_classes = PerfectHashMap<ScAddr>(std::move(entries));
+}
+
+ScAddr const * ScheduleCodes::CodeMap::Find(std::string_view code) const
+{
+  return m_classes.Find(code);
+}
+
+std::string_view ScheduleCodes::CodeMap::FindCode(ScAddr const & classAddr) const
+{
+  auto const it = m_canonicalCodes.find(classAddr);
+  return it != m_canonicalCodes.cend() ? std::string_view(it->second) : std::string_view();
+}
+
+std::vector<ScAddr> const & ScheduleCodes::CodeMap::GetClasses() const
+{
+  return m_classOrder;
+}
+
+size_t ScheduleCodes::CodeMap::Size() const
+{
+  return m_classes.Size();
+}
+
+// Порядок обхода SC-memory не совпадает с порядком объявления в базе знаний, поэтому записи упорядочиваются
+// явно: по системному идентификатору класса, затем по коду. Повторяющийся код достаётся классу
+// с меньшим идентификатором (код из базы знаний — раньше кода по умолчанию), каноническим кодом класса
+// становится наименьший из его кодов
+ScheduleCodes::CodeMap ScheduleCodes::LoadCodes(
+    ScMemoryContext & context, ScAddr const & relation, std::vector<CodeMap::Entry> const & defaultCodes)
+{
+  struct Candidate
+  {
+    bool isDefault;
+    std::string classIdentifier;
+    ScAddr classAddr;
+    std::string code;
+  };
+  std::vector<Candidate> candidates;
+  ScAddrUnorderedSet classesWithCodes;
+
+  ScIterator5Ptr it = context.CreateIterator5(
+      ScType::ConstNodeClass, ScType::ConstCommonArc, ScType::ConstNodeLink, ScType::ConstPermPosArc, relation);
+  while (it->Next())
+  {
+    std::string code;
+    context.GetLinkContent(it->Get(2), code);
+    if (code.empty())
+      continue;
+
+    candidates.push_back({false, std::string(), it->Get(0), std::move(code)});
+    classesWithCodes.insert(it->Get(0));
+  }
+
+  for (auto const & [code, classAddr] : defaultCodes)
+  {
+    if (classesWithCodes.count(classAddr) == 0)
+      candidates.push_back({true, std::string(), classAddr, code});
+  }
+
+  std::unordered_map<ScAddr, std::string, ScAddrHashFunc> identifiers;
+  for (Candidate & candidate : candidates)
+  {
+    auto const [identifier, isNew] = identifiers.try_emplace(candidate.classAddr);
+    if (isNew)
+      identifier->second = context.GetElementSystemIdentifier(candidate.classAddr);
+    candidate.classIdentifier = identifier->second;
+  }
+
+  // Классы без системного идентификатора различаются адресом
+  auto const getKey = [](Candidate const & candidate) {
+    return std::tuple<std::string const &, decltype(candidate.classAddr.Hash()), std::string const &>(
+        candidate.classIdentifier, candidate.classAddr.Hash(), candidate.code);
+  };
+  std::sort(candidates.begin(), candidates.end(), [&getKey](Candidate const & a, Candidate const & b) {
+    return std::make_pair(a.isDefault, getKey(a)) < std::make_pair(b.isDefault, getKey(b));
+  });
+
+  std::unordered_set<std::string> codes;
+  std::vector<Candidate> accepted;
+  for (Candidate & candidate : candidates)
+  {
+    if (codes.insert(candidate.code).second)
+      accepted.push_back(std::move(candidate));
+  }
+  std::sort(accepted.begin(), accepted.end(), [&getKey](Candidate const & a, Candidate const & b) {
+    return getKey(a) < getKey(b);
+  });
+
+  std::vector<CodeMap::Entry> entries;
+  entries.reserve(accepted.size());
+  for (Candidate & candidate : accepted)
+    entries.emplace_back(std::move(candidate.code), candidate.classAddr);
+  return CodeMap(std::move(entries));
+}
+
+ScheduleCodes::CodeMap ScheduleCodes::LoadProfessionMap(ScMemoryContext & context)
+{
+  return LoadCodes(
+      context,
+      SchedulingKeynodes::nrel_profession_code,
+      {{"повар", SchedulingKeynodes::concept_cook},
+       {"официант", SchedulingKeynodes::concept_waiter},
+       {"уборщик", SchedulingKeynodes::concept_cleaner},
+       {"администратор", SchedulingKeynodes::concept_admin}});
+}
+
+ScheduleCodes::CodeMap ScheduleCodes::LoadShiftMap(ScMemoryContext & context)
+{
+  return LoadCodes(
+      context,
+      SchedulingKeynodes::nrel_shift_code,
+      {{"M", SchedulingKeynodes::concept_morning_shift},
+       {"D", SchedulingKeynodes::concept_day_shift},
+       {"N", SchedulingKeynodes::concept_night_shift}});
+}
+
+
+std::vector<ScAddr> ScheduleCodes::GetWeekdays()
+{
+  return {
+      SchedulingKeynodes::monday,    SchedulingKeynodes::tuesday,  SchedulingKeynodes::wednesday,
+      SchedulingKeynodes::thursday,  SchedulingKeynodes::friday,   SchedulingKeynodes::saturday,
+      SchedulingKeynodes::sunday
+  };
+}
+
+std::vector<ScAddr> ScheduleCodes::GetShiftTypes()
+{
+  return {
+      SchedulingKeynodes::concept_morning_shift,
+      SchedulingKeynodes::concept_day_shift,
+      SchedulingKeynodes::concept_night_shift
+  };
+}
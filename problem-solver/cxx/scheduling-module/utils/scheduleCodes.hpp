@@ -0,0 +1,61 @@
+#pragma once
+
+#include <sc-memory/sc_memory.hpp>
+
+#include "perfectHashMap.hpp"
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Кодовые таблицы профессий и смен, общие для импорта штата и экспорта расписаний
+class ScheduleCodes
+{
+public:
+  // Таблица загружается из базы знаний в начале каждого действия импорта или выгрузки, потому что
+  // коды можно менять без перезапуска модуля; во время действия она только читается.
+  // Поиск класса по коду идёт по совершенной хеш-таблице, обратно — по отдельному словарю:
+  // каноническим кодом класса считается его первая запись
+  class CodeMap
+  {
+  public:
+    using Entry = PerfectHashMap<ScAddr>::Entry;
+
+    CodeMap() = default;
+
+    // Порядок записей задаёт порядок классов и канонический код; повторяющиеся коды недопустимы
+    explicit CodeMap(std::vector<Entry> entries);
+
+    ScAddr const * Find(std::string_view code) const;
+
+    // Канонический код класса, пустая строка для неизвестного класса
+    std::string_view FindCode(ScAddr const & classAddr) const;
+
+    // Классы таблицы в порядке записей, каждый один раз
+    std::vector<ScAddr> const & GetClasses() const;
+
+    size_t Size() const;
+
+  private:
+    PerfectHashMap<ScAddr> m_classes;
+    std::unordered_map<ScAddr, std::string, ScAddrHashFunc> m_canonicalCodes;
+    std::vector<ScAddr> m_classOrder;
+  };
+
+  // Коды задаются в базе знаний ссылками nrel_profession_code и nrel_shift_code у классов;
+  // классы без кодов в базе знаний получают коды по умолчанию. Классы упорядочены по системному
+  // идентификатору, канонический код класса — наименьший из его кодов
+  static CodeMap LoadProfessionMap(ScMemoryContext & context);
+  static CodeMap LoadShiftMap(ScMemoryContext & context);
+
+  // Порядок дней недели и смен, в котором они идут в расписании
+  static std::vector<ScAddr> GetWeekdays();
+  static std::vector<ScAddr> GetShiftTypes();
+
+private:
+  static CodeMap LoadCodes(
+      ScMemoryContext & context,
+      ScAddr const & relation,
+      std::vector<CodeMap::Entry> const & defaultCodes);
+};
@@ -0,0 +1,90 @@
+#include "scheduleCollector.hpp"
+#include "keynodes/scheduling-keynodes.hpp"
+
+ScheduleCollector::ScheduleCollector(ScMemoryContext & context)
+  : m_context(context)
+{
+}
+
+// Элемент удерживает только расписание, которое остаётся в памяти. Структуры изменений и результаты
+// запросов (графики сотрудников, составы смен) лишь ссылаются на элементы расписания и их не удерживают
+bool ScheduleCollector::IsUsedByRetainedSchedule(ScAddr const & element)
+{
+  ScIterator3Ptr it = m_context.CreateIterator3(ScType::ConstNodeStructure, ScType::ConstPermPosArc, element);
+  while (it->Next())
+  {
+    ScAddr structure = it->Get(0);
+    if (m_erasedStructures.count(structure) == 0 &&
+        m_context.CheckConnector(SchedulingKeynodes::concept_schedule, structure, ScType::ConstPermPosArc))
+      return true;
+  }
+  return false;
+}
+
+void ScheduleCollector::CollectGraph(ScAddr const & graph, std::vector<ScAddr> & elements)
+{
+  // Доли графа (узлы слотов общие для всех построений и не удаляются)
+  std::vector<ScAddr> const partRelations = {SchedulingKeynodes::nrel_left_part, SchedulingKeynodes::nrel_right_part};
+  for (ScAddr const & relation : partRelations)
+  {
+    ScIterator5Ptr itPart = m_context.CreateIterator5(
+        graph, ScType::ConstCommonArc, ScType::ConstNode, ScType::ConstPermPosArc, relation);
+    while (itPart->Next())
+      elements.push_back(itPart->Get(2));
+  }
+
+  // Рёбра паросочетания между сотрудниками и слотами
+  ScIterator3Ptr itEdge = m_context.CreateIterator3(graph, ScType::ConstPermPosArc, ScType::ConstCommonArc);
+  while (itEdge->Next())
+    elements.push_back(itEdge->Get(2));
+
+  elements.push_back(graph);
+}
+
+void ScheduleCollector::CollectSchedule(ScAddr const & schedule, std::vector<ScAddr> & elements)
+{
+  ScIterator3Ptr itElement = m_context.CreateIterator3(schedule, ScType::ConstPermPosArc, ScType::Unknown);
+  while (itElement->Next())
+  {
+    ScAddr element = itElement->Get(2);
+    if (IsUsedByRetainedSchedule(element))
+      continue;
+
+    if (m_context.CheckConnector(SchedulingKeynodes::concept_bipartite_graph, element, ScType::ConstPermPosArc))
+      CollectGraph(element, elements);
+    else
+      elements.push_back(element);
+  }
+
+  // Атрибуты расписания, заданные ссылками (версия и т.п.)
+  ScIterator3Ptr itAttribute = m_context.CreateIterator3(schedule, ScType::ConstCommonArc, ScType::ConstNodeLink);
+  while (itAttribute->Next())
+    elements.push_back(itAttribute->Get(2));
+
+  // Структура изменений относительно предыдущего расписания
+  ScIterator5Ptr itDiff = m_context.CreateIterator5(
+      schedule, ScType::ConstCommonArc, ScType::ConstNodeStructure, ScType::ConstPermPosArc,
+      SchedulingKeynodes::nrel_schedule_diff);
+  while (itDiff->Next())
+    elements.push_back(itDiff->Get(2));
+
+  elements.push_back(schedule);
+}
+
+size_t ScheduleCollector::Erase(std::vector<ScAddr> const & schedules)
+{
+  m_erasedStructures.insert(schedules.begin(), schedules.end());
+
+  std::vector<ScAddr> elements;
+  for (ScAddr const & schedule : schedules)
+    CollectSchedule(schedule, elements);
+
+  // Удаление узла удаляет и все инцидентные ему дуги, поэтому элемент мог исчезнуть раньше
+  size_t erasedCount = 0;
+  for (ScAddr const & element : elements)
+  {
+    if (m_context.IsElement(element) && m_context.EraseElement(element))
+      erasedCount++;
+  }
+  return erasedCount;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <sc-memory/sc_memory.hpp>
+
+#include <vector>
+
+// Удаляет устаревшие расписания вместе со всеми созданными для них элементами
+class ScheduleCollector
+{
+public:
+  explicit ScheduleCollector(ScMemoryContext & context);
+
+  // Удаляет расписания за один проход, возвращает количество удалённых элементов
+  size_t Erase(std::vector<ScAddr> const & schedules);
+
+private:
+  ScMemoryContext & m_context;
+  ScAddrUnorderedSet m_erasedStructures;
+
+  void CollectSchedule(ScAddr const & schedule, std::vector<ScAddr> & elements);
+  void CollectGraph(ScAddr const & graph, std::vector<ScAddr> & elements);
+  bool IsUsedByRetainedSchedule(ScAddr const & element);
+};
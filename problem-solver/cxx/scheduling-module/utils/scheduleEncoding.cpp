@@ -0,0 +1,79 @@
+#include "scheduleEncoding.hpp"
+
+namespace
+{
+
+char const MAGIC[] = {'S', 'C', 'H', 'D'};
+
+template <typename T>
+void WriteLittleEndian(std::string & out, T value)
+{
+  for (size_t i = 0; i < sizeof(T); ++i)
+    out.push_back(static_cast<char>((value >> (8 * i)) & 0xFF));
+}
+
+template <typename T>
+T ReadLittleEndian(std::string const & data, size_t offset)
+{
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); ++i)
+    value |= static_cast<T>(static_cast<unsigned char>(data[offset + i])) << (8 * i);
+  return value;
+}
+
+}  // namespace
+
+uint32_t ScheduleEncoding::GetShiftBit(size_t dayIndex, size_t shiftIndex, size_t shiftsCount)
+{
+  return 1u << (dayIndex * shiftsCount + shiftIndex);
+}
+
+std::string ScheduleEncoding::Encode(EncodedSchedule const & schedule)
+{
+  uint32_t const employeeCount = schedule.employeeIds.size();
+
+  std::string out;
+  out.reserve(HEADER_SIZE + employeeCount * (sizeof(uint64_t) + sizeof(uint32_t)));
+
+  out.append(MAGIC, sizeof(MAGIC));
+  out.push_back(static_cast<char>(VERSION));
+  out.push_back(static_cast<char>(schedule.daysCount));
+  out.push_back(static_cast<char>(schedule.shiftsCount));
+  out.push_back(0);
+  WriteLittleEndian<uint32_t>(out, employeeCount);
+
+  for (uint64_t id : schedule.employeeIds)
+    WriteLittleEndian<uint64_t>(out, id);
+
+  for (size_t i = 0; i < employeeCount; ++i)
+    WriteLittleEndian<uint32_t>(out, i < schedule.shiftMasks.size() ? schedule.shiftMasks[i] : 0);
+
+  return out;
+}
+
+bool ScheduleEncoding::Decode(std::string const & data, EncodedSchedule & schedule)
+{
+  if (data.size() < HEADER_SIZE || data.compare(0, sizeof(MAGIC), MAGIC, sizeof(MAGIC)) != 0)
+    return false;
+
+  if (static_cast<uint8_t>(data[4]) != VERSION)
+    return false;
+
+  uint32_t const employeeCount = ReadLittleEndian<uint32_t>(data, 8);
+  if (data.size() != HEADER_SIZE + static_cast<size_t>(employeeCount) * (sizeof(uint64_t) + sizeof(uint32_t)))
+    return false;
+
+  schedule.daysCount = static_cast<uint8_t>(data[5]);
+  schedule.shiftsCount = static_cast<uint8_t>(data[6]);
+  schedule.employeeIds.resize(employeeCount);
+  schedule.shiftMasks.resize(employeeCount);
+
+  size_t offset = HEADER_SIZE;
+  for (uint32_t i = 0; i < employeeCount; ++i, offset += sizeof(uint64_t))
+    schedule.employeeIds[i] = ReadLittleEndian<uint64_t>(data, offset);
+
+  for (uint32_t i = 0; i < employeeCount; ++i, offset += sizeof(uint32_t))
+    schedule.shiftMasks[i] = ReadLittleEndian<uint32_t>(data, offset);
+
+  return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Компактное представление недельного расписания (сотрудники × дни × смены).
+//
+// Формат (все числа little-endian):
+//   смещение  размер  поле
+//   0         4       сигнатура "SCHD"
+//   4         1       версия формата (1)
+//   5         1       количество дней D
+//   6         1       количество смен в дне S
+//   7         1       зарезервировано (0)
+//   8         4       количество сотрудников N (uint32)
+//   12        8 * N   идентификаторы сотрудников (uint64, хэш ScAddr)
+//   12 + 8N   4 * N   маски смен сотрудников (uint32, бит d * S + s — смена s в день d)
+//
+// Идентификаторы и маски хранятся отдельными столбцами в одном порядке.
+struct EncodedSchedule
+{
+  uint8_t daysCount = 0;
+  uint8_t shiftsCount = 0;
+  std::vector<uint64_t> employeeIds;
+  std::vector<uint32_t> shiftMasks;
+};
+
+class ScheduleEncoding
+{
+public:
+  static constexpr uint8_t VERSION = 1;
+  static constexpr size_t HEADER_SIZE = 12;
+
+  static std::string Encode(EncodedSchedule const & schedule);
+  static bool Decode(std::string const & data, EncodedSchedule & schedule);
+
+  static uint32_t GetShiftBit(size_t dayIndex, size_t shiftIndex, size_t shiftsCount);
+};
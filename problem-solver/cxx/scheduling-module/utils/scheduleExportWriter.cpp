@@ -0,0 +1,204 @@
+#include "scheduleExportWriter.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+
+struct ShiftHours
+{
+  int start;
+  int end;
+};
+
+// Утренняя 06–14, дневная 14–22, ночная 22–06 следующего дня
+ShiftHours const SHIFT_HOURS[] = {{6, 14}, {14, 22}, {22, 6}};
+
+// Преобразования между гражданской датой и числом дней от 1970-01-01 (пролептический григорианский календарь)
+int64_t DaysFromCivil(int64_t year, unsigned month, unsigned day)
+{
+  year -= month <= 2;
+  int64_t const era = (year >= 0 ? year : year - 399) / 400;
+  unsigned const yearOfEra = static_cast<unsigned>(year - era * 400);
+  unsigned const dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+  unsigned const dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+  return era * 146097 + static_cast<int64_t>(dayOfEra) - 719468;
+}
+
+void CivilFromDays(int64_t days, int64_t & year, unsigned & month, unsigned & day)
+{
+  days += 719468;
+  int64_t const era = (days >= 0 ? days : days - 146096) / 146097;
+  unsigned const dayOfEra = static_cast<unsigned>(days - era * 146097);
+  unsigned const yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+  unsigned const dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+  unsigned const mp = (5 * dayOfYear + 2) / 153;
+  day = dayOfYear - (153 * mp + 2) / 5 + 1;
+  month = mp < 10 ? mp + 3 : mp - 9;
+  year = static_cast<int64_t>(yearOfEra) + era * 400 + (month <= 2);
+}
+
+}  // namespace
+
+void CsvScheduleWriter::Begin()
+{
+  m_out << "day,shift,profession,name\n";
+}
+
+void CsvScheduleWriter::Write(ScheduleExportRow const & row)
+{
+  m_out << EscapeField(row.dayCode) << ',' << EscapeField(row.shiftCode) << ',' << EscapeField(row.profession)
+        << ',' << EscapeField(row.name) << '\n';
+}
+
+void CsvScheduleWriter::End()
+{
+  m_out.flush();
+}
+
+std::string CsvScheduleWriter::EscapeField(std::string const & field)
+{
+  if (field.find_first_of(",\"\r\n") == std::string::npos)
+    return field;
+
+  std::string escaped = "\"";
+  for (char c : field)
+  {
+    if (c == '"')
+      escaped += '"';
+    escaped += c;
+  }
+  escaped += '"';
+  return escaped;
+}
+
+IcsScheduleWriter::IcsScheduleWriter(std::ostream & out, int64_t weekStart)
+  : ScheduleExportWriter(out)
+  , m_weekStart(weekStart)
+{
+}
+
+void IcsScheduleWriter::Begin()
+{
+  m_out << "BEGIN:VCALENDAR\r\n"
+        << "VERSION:2.0\r\n"
+        << "PRODID:-//OSTIS//scheduling-module//RU\r\n"
+        << "CALSCALE:GREGORIAN\r\n";
+}
+
+void IcsScheduleWriter::Write(ScheduleExportRow const & row)
+{
+  ShiftHours const hours = SHIFT_HOURS[row.shiftIndex % 3];
+  int64_t const startDay = m_weekStart + static_cast<int64_t>(row.dayIndex);
+  int64_t const endDay = hours.end <= hours.start ? startDay + 1 : startDay;
+
+  m_out << "BEGIN:VEVENT\r\n"
+        << "UID:" << row.uid << '-' << row.dayIndex << '-' << row.shiftIndex << "@scheduling-module\r\n"
+        << "DTSTAMP:" << FormatDateTime(m_weekStart, 0) << "Z\r\n"
+        << "DTSTART:" << FormatDateTime(startDay, hours.start) << "\r\n"
+        << "DTEND:" << FormatDateTime(endDay, hours.end) << "\r\n"
+        << FoldLine("SUMMARY:" + EscapeText(row.name + " (" + row.profession + ")")) << "\r\n"
+        << FoldLine("CATEGORIES:" + EscapeText(row.shiftCode)) << "\r\n"
+        << "END:VEVENT\r\n";
+}
+
+void IcsScheduleWriter::End()
+{
+  m_out << "END:VCALENDAR\r\n";
+  m_out.flush();
+}
+
+std::string IcsScheduleWriter::EscapeText(std::string const & text)
+{
+  std::string escaped;
+  escaped.reserve(text.size());
+  for (char c : text)
+  {
+    switch (c)
+    {
+    case '\\':
+    case ';':
+    case ',':
+      escaped += '\\';
+      escaped += c;
+      break;
+    case '\n':
+      escaped += "\\n";
+      break;
+    case '\r':
+      break;
+    default:
+      escaped += c;
+    }
+  }
+  return escaped;
+}
+
+// RFC 5545 §3.1: строка длиннее 75 октетов переносится через CRLF и пробел; продолжение вместе
+// с пробелом тоже не длиннее 75 октетов. Перенос не разрывает последовательность UTF-8
+std::string IcsScheduleWriter::FoldLine(std::string const & line)
+{
+  if (line.size() <= MAX_LINE_OCTETS)
+    return line;
+
+  std::string folded;
+  folded.reserve(line.size() + line.size() / (MAX_LINE_OCTETS - 1) * 3);
+  size_t position = 0;
+  size_t limit = MAX_LINE_OCTETS;
+  while (line.size() - position > limit)
+  {
+    size_t end = position + limit;
+    while (end > position && (static_cast<unsigned char>(line[end]) & 0xC0) == 0x80)
+      end--;
+    folded.append(line, position, end - position);
+    folded += "\r\n ";
+    position = end;
+    limit = MAX_LINE_OCTETS - 1;
+  }
+  folded.append(line, position, std::string::npos);
+  return folded;
+}
+
+// Принимает дату в виде YYYY-MM-DD или YYYYMMDD
+bool IcsScheduleWriter::ParseDate(std::string const & date, int64_t & days)
+{
+  int year = 0;
+  unsigned month = 0;
+  unsigned day = 0;
+  char tail = 0;
+  if (std::sscanf(date.c_str(), "%4d-%2u-%2u%c", &year, &month, &day, &tail) != 3 &&
+      std::sscanf(date.c_str(), "%4d%2u%2u%c", &year, &month, &day, &tail) != 3)
+    return false;
+
+  if (month < 1 || month > 12 || day < 1 || day > 31)
+    return false;
+
+  days = DaysFromCivil(year, month, day);
+
+  int64_t checkYear = 0;
+  unsigned checkMonth = 0;
+  unsigned checkDay = 0;
+  CivilFromDays(days, checkYear, checkMonth, checkDay);
+  return checkYear == year && checkMonth == month && checkDay == day;
+}
+
+int64_t IcsScheduleWriter::GetCurrentWeekStart()
+{
+  auto const now = std::chrono::system_clock::now().time_since_epoch();
+  int64_t const today = std::chrono::duration_cast<std::chrono::hours>(now).count() / 24;
+  // 1970-01-01 — четверг, понедельник имеет номер 0
+  return today - (today + 3) % 7;
+}
+
+std::string IcsScheduleWriter::FormatDateTime(int64_t days, int hour) const
+{
+  int64_t year = 0;
+  unsigned month = 0;
+  unsigned day = 0;
+  CivilFromDays(days, year, month, day);
+
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%04lld%02u%02uT%02d0000", static_cast<long long>(year), month, day, hour);
+  return buffer;
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Одна строка выгрузки: назначение сотрудника на смену
+struct ScheduleExportRow
+{
+  size_t dayIndex = 0;
+  std::string dayCode;
+  size_t shiftIndex = 0;
+  std::string shiftCode;
+  std::string profession;
+  std::string name;
+  uint64_t uid = 0;
+};
+
+// Потоковая запись расписания: строки пишутся в поток по одной, документ целиком не собирается
+class ScheduleExportWriter
+{
+public:
+  explicit ScheduleExportWriter(std::ostream & out)
+    : m_out(out)
+  {
+  }
+
+  virtual ~ScheduleExportWriter() = default;
+
+  virtual void Begin() = 0;
+  virtual void Write(ScheduleExportRow const & row) = 0;
+  virtual void End() = 0;
+
+protected:
+  std::ostream & m_out;
+};
+
+// CSV: day,shift,profession,name — коды профессий и смен те же, что при импорте штата
+class CsvScheduleWriter : public ScheduleExportWriter
+{
+public:
+  using ScheduleExportWriter::ScheduleExportWriter;
+
+  void Begin() override;
+  void Write(ScheduleExportRow const & row) override;
+  void End() override;
+
+  static std::string EscapeField(std::string const & field);
+};
+
+// iCalendar (RFC 5545): по событию VEVENT на каждое назначение.
+// Неделя отсчитывается от понедельника weekStart (дни от 1970-01-01), время смен — локальное
+class IcsScheduleWriter : public ScheduleExportWriter
+{
+public:
+  IcsScheduleWriter(std::ostream & out, int64_t weekStart);
+
+  void Begin() override;
+  void Write(ScheduleExportRow const & row) override;
+  void End() override;
+
+  static constexpr size_t MAX_LINE_OCTETS = 75;
+
+  static std::string EscapeText(std::string const & text);
+  static std::string FoldLine(std::string const & line);
+  static bool ParseDate(std::string const & date, int64_t & days);
+  static int64_t GetCurrentWeekStart();
+
+private:
+  std::string FormatDateTime(int64_t days, int hour) const;
+
+  int64_t m_weekStart;
+};
@@ -0,0 +1,289 @@
+#include "staffCsvReader.hpp"
+#include "csvScanner.hpp"
+#include "parallelShards.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+namespace
+{
+
+std::string_view const UTF8_BOM = "\xEF\xBB\xBF";
+
+bool IsSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f';
+}
+
+// Состояния разбора, от которых зависит смысл кавычки и перевода строки
+enum class CsvState : uint8_t
+{
+  FieldStart,     // Начало поля: кавычка открывает поле в кавычках
+  Unquoted,       // Поле без кавычек или хвост после закрывающей кавычки: кавычка — обычный символ
+  Quoted,         // Внутри кавычек: перевод строки не завершает запись
+  QuoteInQuoted   // Кавычка внутри кавычек: закрывающая или первая из удвоенных
+};
+
+size_t const CSV_STATE_COUNT = 4;
+
+// Переходы по тем же правилам, что и в NextRecord
+class CsvStateMachine
+{
+public:
+  explicit CsvStateMachine(char delimiter)
+  {
+    for (size_t state = 0; state < CSV_STATE_COUNT; ++state)
+    {
+      for (size_t c = 0; c < 256; ++c)
+        m_transitions[state][c] = GetNextState(static_cast<CsvState>(state), static_cast<char>(c), delimiter);
+    }
+  }
+
+  CsvState Next(CsvState state, char c) const
+  {
+    return m_transitions[static_cast<size_t>(state)][static_cast<unsigned char>(c)];
+  }
+
+private:
+  static CsvState GetNextState(CsvState state, char c, char delimiter)
+  {
+    if (state == CsvState::Quoted)
+      return c == '"' ? CsvState::QuoteInQuoted : CsvState::Quoted;
+    if (state == CsvState::QuoteInQuoted && c == '"')
+      return CsvState::Quoted;
+    if (c == delimiter || c == '\n' || c == '\r')
+      return CsvState::FieldStart;
+    if (state == CsvState::FieldStart && c == '"')
+      return CsvState::Quoted;
+    if (state == CsvState::FieldStart && (c == ' ' || c == '\t'))
+      return CsvState::FieldStart;
+    return CsvState::Unquoted;
+  }
+
+  std::array<std::array<CsvState, 256>, CSV_STATE_COUNT> m_transitions;
+};
+
+}  // namespace
+
+StaffCsvReader::StaffCsvReader(std::string_view data, char delimiter)
+  : m_data(data)
+  , m_delimiter(delimiter)
+{
+  if (m_data.substr(0, UTF8_BOM.size()) == UTF8_BOM)
+    m_position = UTF8_BOM.size();
+}
+
+std::string_view StaffCsvReader::Trim(std::string_view value)
+{
+  while (!value.empty() && IsSpace(value.front()))
+    value.remove_prefix(1);
+  while (!value.empty() && IsSpace(value.back()))
+    value.remove_suffix(1);
+  return value;
+}
+
+// Пропускает пробелы и табуляции, если они не служат разделителем
+void StaffCsvReader::SkipBlanks()
+{
+  while (m_position < m_data.size() && m_data[m_position] != m_delimiter &&
+         (m_data[m_position] == ' ' || m_data[m_position] == '\t'))
+    m_position++;
+}
+
+std::string_view StaffCsvReader::ReadUnquotedField()
+{
+  size_t const start = m_position;
+  size_t end = CsvScanner::FindStructural(m_data, m_position, m_delimiter);
+  // Кавычка внутри поля без кавычек — обычный символ
+  while (end < m_data.size() && m_data[end] == '"')
+    end = CsvScanner::FindStructural(m_data, end + 1, m_delimiter);
+
+  m_position = end;
+  return Trim(m_data.substr(start, end - start));
+}
+
+// Поле в кавычках; незакрытая кавычка продолжает поле до конца данных
+std::string_view StaffCsvReader::ReadQuotedField()
+{
+  size_t const start = ++m_position;
+  size_t end = m_data.size();
+  bool hasEscapedQuotes = false;
+
+  while (m_position < m_data.size())
+  {
+    size_t const quote = m_data.find('"', m_position);
+    if (quote == std::string_view::npos)
+    {
+      m_position = m_data.size();
+      break;
+    }
+    if (quote + 1 < m_data.size() && m_data[quote + 1] == '"')
+    {
+      hasEscapedQuotes = true;
+      m_position = quote + 2;
+      continue;
+    }
+    end = quote;
+    m_position = quote + 1;
+    break;
+  }
+
+  // Символы между закрывающей кавычкой и разделителем отбрасываются
+  m_position = CsvScanner::FindStructural(m_data, m_position, m_delimiter);
+  while (m_position < m_data.size() && m_data[m_position] == '"')
+    m_position = CsvScanner::FindStructural(m_data, m_position + 1, m_delimiter);
+
+  std::string_view const field = m_data.substr(start, end - start);
+  if (!hasEscapedQuotes)
+    return field;
+
+  if (m_unescapedUsed == m_unescaped.size())
+    m_unescaped.emplace_back();
+  std::string & unescaped = m_unescaped[m_unescapedUsed++];
+  unescaped.clear();
+  for (size_t i = 0; i < field.size(); ++i)
+  {
+    unescaped += field[i];
+    if (field[i] == '"')
+      i++;
+  }
+  return unescaped;
+}
+
+bool StaffCsvReader::NextRecord(CsvFields & fields)
+{
+  while (m_position < m_data.size())
+  {
+    fields.clear();
+    m_unescapedUsed = 0;
+    bool hasQuotedField = false;
+
+    while (true)
+    {
+      SkipBlanks();
+      if (m_position < m_data.size() && m_data[m_position] == '"')
+      {
+        hasQuotedField = true;
+        fields.push_back(ReadQuotedField());
+      }
+      else
+        fields.push_back(ReadUnquotedField());
+
+      if (m_position >= m_data.size())
+        break;
+
+      char const c = m_data[m_position++];
+      if (c == m_delimiter)
+        continue;
+      if (c == '\r' && m_position < m_data.size() && m_data[m_position] == '\n')
+        m_position++;
+      break;
+    }
+
+    // Пустые строки пропускаются
+    if (fields.size() > 1 || hasQuotedField || !fields.front().empty())
+      return true;
+  }
+  return false;
+}
+
+size_t StaffCsvReader::GetPosition() const
+{
+  return m_position;
+}
+
+std::vector<std::string_view> StaffCsvReader::SplitChunks(
+    std::string_view data, size_t chunkCount, char delimiter)
+{
+  size_t const bomSize = data.substr(0, UTF8_BOM.size()) == UTF8_BOM ? UTF8_BOM.size() : 0;
+  size_t const size = data.size() - bomSize;
+  chunkCount = std::max<size_t>(std::min(chunkCount, size), 1);
+  if (chunkCount == 1)
+    return {data};
+
+  std::vector<size_t> starts(chunkCount);
+  for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+    starts[chunk] = bomSize + size / chunkCount * chunk;
+
+  // Состояние в конце каждой части для каждого возможного состояния в её начале: части просматриваются
+  // параллельно, затем состояния на границах вычисляются последовательно по этим таблицам
+  CsvStateMachine const machine(delimiter);
+  using StateTransfer = std::array<CsvState, CSV_STATE_COUNT>;
+  std::vector<StateTransfer> transfers(chunkCount);
+  RunShards(chunkCount, [&](size_t chunk) {
+    size_t const end = chunk + 1 < chunkCount ? starts[chunk + 1] : data.size();
+    StateTransfer states;
+    for (size_t state = 0; state < CSV_STATE_COUNT; ++state)
+      states[state] = static_cast<CsvState>(state);
+    for (size_t position = starts[chunk]; position < end; ++position)
+    {
+      for (CsvState & state : states)
+        state = machine.Next(state, data[position]);
+    }
+    transfers[chunk] = states;
+  });
+
+  std::vector<std::string_view> chunks;
+  size_t begin = 0;
+  CsvState chunkState = CsvState::FieldStart;
+  for (size_t chunk = 1; chunk < chunkCount; ++chunk)
+  {
+    chunkState = transfers[chunk - 1][static_cast<size_t>(chunkState)];
+
+    // Граница сдвигается к ближайшему концу записи; предыдущая граница сама стоит в начале записи
+    size_t position = std::max(starts[chunk], begin);
+    CsvState state = position == starts[chunk] ? chunkState : CsvState::FieldStart;
+    while (position < data.size() && (data[position] != '\n' || state == CsvState::Quoted))
+      state = machine.Next(state, data[position++]);
+
+    if (position >= data.size())
+      break;
+    chunks.push_back(data.substr(begin, position + 1 - begin));
+    begin = position + 1;
+  }
+
+  if (begin < data.size() || chunks.empty())
+    chunks.push_back(data.substr(begin));
+  return chunks;
+}
+
+void StaffCsvReader::ParseRow(CsvFields const & fields, CsvFormat const & format, StaffCsvRecord & record)
+{
+  // Колонки id и op могут стоять где угодно, остальные колонки нумеруются без них
+  int specialColumns[] = {format.idColumn, format.opColumn};
+  std::sort(std::begin(specialColumns), std::end(specialColumns));
+
+  auto const getPhysicalField = [&fields](int index) {
+    return index >= 0 && static_cast<size_t>(index) < fields.size() ? fields[index] : std::string_view();
+  };
+  auto const getField = [&](int index) {
+    for (int column : specialColumns)
+    {
+      if (column >= 0 && index >= column)
+        index++;
+    }
+    return getPhysicalField(index);
+  };
+
+  record = StaffCsvRecord();
+  record.id = getPhysicalField(format.idColumn);
+  record.op = getPhysicalField(format.opColumn);
+  record.profession = getField(0);
+  record.name = getField(1);
+  std::string_view const col3 = getField(2);
+  std::string_view const col4 = format.columnCount >= 4 ? getField(3) : std::string_view();
+
+  if (format.columnCount >= 4)
+  {
+    record.allowedShifts = col3;
+    record.forbiddenShifts = col4;
+  }
+  else if (format.columnCount == 3)
+  {
+    if (format.hasForbiddenColumn && !format.hasAllowedColumn)
+      record.forbiddenShifts = col3;
+    else
+      record.allowedShifts = col3;
+  }
+}
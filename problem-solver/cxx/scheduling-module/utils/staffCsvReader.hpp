@@ -0,0 +1,88 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Формат CSV-файла штата, определяемый по заголовку
+struct CsvFormat
+{
+  bool hasForbiddenColumn = false;
+  bool hasAllowedColumn = false;
+  int columnCount = 0;  // Без колонок идентификатора и операции
+  int idColumn = -1;    // Номер колонки id в строке или -1, если её нет
+  int opColumn = -1;    // Номер колонки op в строке или -1, если её нет
+};
+
+// Поля записи CSV. Действительны до следующего вызова NextRecord, пока существует буфер
+using CsvFields = std::vector<std::string_view>;
+
+// Поля строки CSV-файла штата
+struct StaffCsvRecord
+{
+  std::string_view id;
+  std::string_view op;
+  std::string_view profession;
+  std::string_view name;
+  std::string_view allowedShifts;
+  std::string_view forbiddenShifts;
+};
+
+// Потоковый разбор CSV по RFC 4180 без копирования: буфер просматривается один раз,
+// поля возвращаются срезами буфера. Поддерживаются поля в кавычках (с разделителями, переводами строк
+// и удвоенными кавычками внутри), произвольный разделитель, BOM UTF-8 и окончания строк CRLF.
+// Копируются только поля с удвоенными кавычками — в буферы читателя
+class StaffCsvReader
+{
+public:
+  static constexpr char DEFAULT_DELIMITER = ',';
+
+  explicit StaffCsvReader(std::string_view data, char delimiter = DEFAULT_DELIMITER);
+
+  // Следующая непустая запись. Поля без кавычек очищаются от начальных и концевых пробелов
+  bool NextRecord(CsvFields & fields);
+
+  // Смещение первого непрочитанного байта
+  size_t GetPosition() const;
+
+  // Делит данные не более чем на chunkCount частей, каждая из которых заканчивается концом записи.
+  // Перевод строки внутри кавычек границей не считается. Кавычки учитываются по правилам NextRecord:
+  // открывающей считается только кавычка в начале поля, поэтому кавычка внутри поля без кавычек
+  // не сдвигает последующие границы
+  static std::vector<std::string_view> SplitChunks(
+      std::string_view data, size_t chunkCount, char delimiter = DEFAULT_DELIMITER);
+
+  static void ParseRow(CsvFields const & fields, CsvFormat const & format, StaffCsvRecord & record);
+  static std::string_view Trim(std::string_view value);
+
+  // Вызывает func для каждого непустого кода смены из списка через ';'
+  template <typename TFunc>
+  static void ForEachShiftCode(std::string_view shifts, TFunc && func)
+  {
+    while (!shifts.empty())
+    {
+      size_t const separator = shifts.find(';');
+      std::string_view const code = Trim(shifts.substr(0, separator));
+      if (!code.empty())
+        func(code);
+      if (separator == std::string_view::npos)
+        break;
+      shifts.remove_prefix(separator + 1);
+    }
+  }
+
+private:
+  std::string_view ReadQuotedField();
+  std::string_view ReadUnquotedField();
+  void SkipBlanks();
+
+  std::string_view m_data;
+  char m_delimiter;
+  size_t m_position = 0;
+
+  // Раскавыченные поля текущей записи; deque не перемещает строки при добавлении
+  std::deque<std::string> m_unescaped;
+  size_t m_unescapedUsed = 0;
+};
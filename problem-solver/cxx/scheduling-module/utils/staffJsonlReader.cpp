@@ -0,0 +1,403 @@
+#include "staffJsonlReader.hpp"
+
+#include <algorithm>
+
+namespace
+{
+
+std::string_view const UTF8_BOM = "\xEF\xBB\xBF";
+
+bool IsSpace(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+bool IsNumberSymbol(char c)
+{
+  return (c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+}  // namespace
+
+StaffJsonlReader::StaffJsonlReader(std::string_view data)
+  : m_data(data)
+{
+  if (m_data.substr(0, UTF8_BOM.size()) == UTF8_BOM)
+    m_position = UTF8_BOM.size();
+}
+
+size_t StaffJsonlReader::GetInvalidCount() const
+{
+  return m_invalidCount;
+}
+
+size_t StaffJsonlReader::GetFirstInvalidLine() const
+{
+  return m_firstInvalidLine;
+}
+
+bool StaffJsonlReader::NextRecord(StaffCsvRecord & record)
+{
+  m_unescapedUsed = 0;
+  while (m_position < m_data.size())
+  {
+    size_t const end = std::min(m_data.find('\n', m_position), m_data.size());
+    m_line = m_data.substr(m_position, end - m_position);
+    m_linePosition = 0;
+    m_position = end + 1;
+    m_lineNumber++;
+
+    SkipSpaces();
+    if (m_linePosition == m_line.size())
+      continue;
+
+    record = StaffCsvRecord();
+    if (ParseObject(record))
+      return true;
+
+    if (m_invalidCount++ == 0)
+      m_firstInvalidLine = m_lineNumber;
+    m_unescapedUsed = 0;
+  }
+  return false;
+}
+
+void StaffJsonlReader::SkipSpaces()
+{
+  while (m_linePosition < m_line.size() && IsSpace(m_line[m_linePosition]))
+    m_linePosition++;
+}
+
+std::string & StaffJsonlReader::AcquireBuffer()
+{
+  if (m_unescapedUsed == m_unescaped.size())
+    m_unescaped.emplace_back();
+  std::string & buffer = m_unescaped[m_unescapedUsed++];
+  buffer.clear();
+  return buffer;
+}
+
+// Объект целиком и ничего, кроме пробелов, после него
+bool StaffJsonlReader::ParseObject(StaffCsvRecord & record)
+{
+  if (m_line[m_linePosition] != '{')
+    return false;
+  m_linePosition++;
+  SkipSpaces();
+
+  bool isFirst = true;
+  while (m_linePosition < m_line.size() && m_line[m_linePosition] != '}')
+  {
+    if (!isFirst)
+    {
+      if (m_line[m_linePosition] != ',')
+        return false;
+      m_linePosition++;
+      SkipSpaces();
+    }
+    isFirst = false;
+
+    std::string_view key;
+    if (!ParseString(key))
+      return false;
+    SkipSpaces();
+    if (m_linePosition >= m_line.size() || m_line[m_linePosition] != ':')
+      return false;
+    m_linePosition++;
+    SkipSpaces();
+
+    bool isValid = true;
+    if (key == "id")
+      isValid = ParseScalar(record.id);
+    else if (key == "op" || key == "operation")
+      isValid = ParseString(record.op);
+    else if (key == "profession")
+      isValid = ParseString(record.profession);
+    else if (key == "name")
+      isValid = ParseString(record.name);
+    else if (key == "allowed_shifts")
+      isValid = ParseShiftList(record.allowedShifts);
+    else if (key == "forbidden_shifts")
+      isValid = ParseShiftList(record.forbiddenShifts);
+    else
+      isValid = SkipValue();
+
+    if (!isValid)
+      return false;
+    SkipSpaces();
+  }
+
+  if (m_linePosition >= m_line.size())
+    return false;
+  m_linePosition++;
+  SkipSpaces();
+
+  record.profession = StaffCsvReader::Trim(record.profession);
+  record.name = StaffCsvReader::Trim(record.name);
+  return m_linePosition == m_line.size();
+}
+
+bool StaffJsonlReader::ParseString(std::string_view & value)
+{
+  if (m_linePosition >= m_line.size() || m_line[m_linePosition] != '"')
+    return false;
+  size_t const start = ++m_linePosition;
+
+  // Без экранирования строка возвращается срезом буфера
+  size_t end = start;
+  while (end < m_line.size() && m_line[end] != '"' && m_line[end] != '\\')
+    end++;
+  if (end == m_line.size())
+    return false;
+  if (m_line[end] == '"')
+  {
+    value = m_line.substr(start, end - start);
+    m_linePosition = end + 1;
+    return true;
+  }
+
+  std::string & buffer = AcquireBuffer();
+  buffer.assign(m_line.data() + start, end - start);
+  m_linePosition = end;
+  while (m_linePosition < m_line.size())
+  {
+    char const c = m_line[m_linePosition++];
+    if (c == '"')
+    {
+      value = buffer;
+      return true;
+    }
+    if (c != '\\')
+    {
+      buffer += c;
+      continue;
+    }
+
+    if (m_linePosition >= m_line.size())
+      return false;
+    switch (m_line[m_linePosition++])
+    {
+    case '"':
+      buffer += '"';
+      break;
+    case '\\':
+      buffer += '\\';
+      break;
+    case '/':
+      buffer += '/';
+      break;
+    case 'b':
+      buffer += '\b';
+      break;
+    case 'f':
+      buffer += '\f';
+      break;
+    case 'n':
+      buffer += '\n';
+      break;
+    case 'r':
+      buffer += '\r';
+      break;
+    case 't':
+      buffer += '\t';
+      break;
+    case 'u':
+      if (!AppendUtf8(buffer))
+        return false;
+      break;
+    default:
+      return false;
+    }
+  }
+  return false;
+}
+
+bool StaffJsonlReader::ReadHex(uint32_t & code)
+{
+  if (m_linePosition + 4 > m_line.size())
+    return false;
+
+  code = 0;
+  for (size_t i = 0; i < 4; ++i)
+  {
+    char const c = m_line[m_linePosition++];
+    code <<= 4;
+    if (c >= '0' && c <= '9')
+      code |= c - '0';
+    else if (c >= 'a' && c <= 'f')
+      code |= c - 'a' + 10;
+    else if (c >= 'A' && c <= 'F')
+      code |= c - 'A' + 10;
+    else
+      return false;
+  }
+  return true;
+}
+
+// \uXXXX после '\u'; суррогатная пара собирается в один символ
+bool StaffJsonlReader::AppendUtf8(std::string & out)
+{
+  uint32_t code = 0;
+  if (!ReadHex(code))
+    return false;
+
+  if (code >= 0xD800 && code <= 0xDBFF)
+  {
+    uint32_t low = 0;
+    if (m_line.substr(m_linePosition, 2) != "\\u")
+      return false;
+    m_linePosition += 2;
+    if (!ReadHex(low) || low < 0xDC00 || low > 0xDFFF)
+      return false;
+    code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+  }
+  else if (code >= 0xDC00 && code <= 0xDFFF)
+    return false;
+
+  if (code < 0x80)
+    out += static_cast<char>(code);
+  else if (code < 0x800)
+  {
+    out += static_cast<char>(0xC0 | (code >> 6));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  }
+  else if (code < 0x10000)
+  {
+    out += static_cast<char>(0xE0 | (code >> 12));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  }
+  else
+  {
+    out += static_cast<char>(0xF0 | (code >> 18));
+    out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+    out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    out += static_cast<char>(0x80 | (code & 0x3F));
+  }
+  return true;
+}
+
+// Строка, число (например, числовой id) или null как пустое значение
+bool StaffJsonlReader::ParseScalar(std::string_view & value)
+{
+  if (m_linePosition < m_line.size() && m_line[m_linePosition] == '"')
+    return ParseString(value);
+
+  size_t const start = m_linePosition;
+  while (m_linePosition < m_line.size() && IsNumberSymbol(m_line[m_linePosition]))
+    m_linePosition++;
+  if (m_linePosition > start)
+  {
+    value = m_line.substr(start, m_linePosition - start);
+    return true;
+  }
+
+  if (m_line.substr(m_linePosition, 4) == "null")
+  {
+    m_linePosition += 4;
+    value = {};
+    return true;
+  }
+  return false;
+}
+
+// Строка кодов через ';', массив строк (собирается в ту же форму) или null
+bool StaffJsonlReader::ParseShiftList(std::string_view & value)
+{
+  if (m_linePosition >= m_line.size() || m_line[m_linePosition] != '[')
+    return ParseScalar(value);
+  m_linePosition++;
+  SkipSpaces();
+
+  std::string & codes = AcquireBuffer();
+  bool isFirst = true;
+  while (m_linePosition < m_line.size() && m_line[m_linePosition] != ']')
+  {
+    if (!isFirst)
+    {
+      if (m_line[m_linePosition] != ',')
+        return false;
+      m_linePosition++;
+      SkipSpaces();
+    }
+    isFirst = false;
+
+    std::string_view code;
+    if (!ParseString(code))
+      return false;
+    if (!codes.empty())
+      codes += ';';
+    codes += code;
+    SkipSpaces();
+  }
+  if (m_linePosition >= m_line.size())
+    return false;
+  m_linePosition++;
+
+  value = codes;
+  return true;
+}
+
+// Значение неизвестного поля любого типа, включая вложенные объекты и массивы
+bool StaffJsonlReader::SkipValue()
+{
+  size_t depth = 0;
+  std::string_view ignored;
+  do
+  {
+    SkipSpaces();
+    if (m_linePosition >= m_line.size())
+      return false;
+
+    char const c = m_line[m_linePosition];
+    if (c == '"')
+    {
+      if (!ParseString(ignored))
+        return false;
+    }
+    else if (c == '{' || c == '[')
+    {
+      depth++;
+      m_linePosition++;
+    }
+    else if (c == '}' || c == ']')
+    {
+      if (depth == 0)
+        return false;
+      depth--;
+      m_linePosition++;
+    }
+    else if (c == ',' || c == ':')
+    {
+      if (depth == 0)
+        return false;
+      m_linePosition++;
+    }
+    else if (m_line.substr(m_linePosition, 4) == "true" || m_line.substr(m_linePosition, 4) == "null")
+      m_linePosition += 4;
+    else if (m_line.substr(m_linePosition, 5) == "false")
+      m_linePosition += 5;
+    else if (!ParseScalar(ignored))
+      return false;
+  } while (depth > 0);
+  return true;
+}
+
+std::vector<std::string_view> StaffJsonlReader::SplitChunks(std::string_view data, size_t chunkCount)
+{
+  chunkCount = std::max<size_t>(std::min(chunkCount, data.size()), 1);
+  std::vector<std::string_view> chunks;
+  size_t begin = 0;
+  for (size_t chunk = 1; chunk < chunkCount && begin < data.size(); ++chunk)
+  {
+    size_t const newline = data.find('\n', std::max(data.size() / chunkCount * chunk, begin));
+    if (newline == std::string_view::npos)
+      break;
+    chunks.push_back(data.substr(begin, newline + 1 - begin));
+    begin = newline + 1;
+  }
+
+  if (begin < data.size() || chunks.empty())
+    chunks.push_back(data.substr(begin));
+  return chunks;
+}
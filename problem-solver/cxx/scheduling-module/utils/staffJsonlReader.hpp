@@ -0,0 +1,57 @@
+#pragma once
+
+#include "staffCsvReader.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Потоковый разбор штата в формате JSON Lines: по одному объекту сотрудника в строке
+// с полями id, op (или operation), profession, name, allowed_shifts и forbidden_shifts.
+// Смены задаются строкой кодов через ';' или массивом строк. Буфер просматривается один раз,
+// строки без экранирования возвращаются срезами буфера; копируются только строки с '\' и массивы смен
+class StaffJsonlReader
+{
+public:
+  explicit StaffJsonlReader(std::string_view data);
+
+  // Следующая запись. Пустые строки пропускаются, некорректные — пропускаются и подсчитываются.
+  // Поля записи действительны до следующего вызова, пока существует буфер
+  bool NextRecord(StaffCsvRecord & record);
+
+  size_t GetInvalidCount() const;
+
+  // Номер первой некорректной строки (с единицы) или 0
+  size_t GetFirstInvalidLine() const;
+
+  // Делит данные не более чем на chunkCount частей по концам строк: в JSON перевод строки
+  // внутри значения всегда экранирован
+  static std::vector<std::string_view> SplitChunks(std::string_view data, size_t chunkCount);
+
+private:
+  bool ParseObject(StaffCsvRecord & record);
+  bool ParseString(std::string_view & value);
+  bool ParseShiftList(std::string_view & value);
+  bool ParseScalar(std::string_view & value);
+  bool SkipValue();
+  bool AppendUtf8(std::string & out);
+  bool ReadHex(uint32_t & code);
+  void SkipSpaces();
+
+  std::string & AcquireBuffer();
+
+  std::string_view m_data;
+  size_t m_position = 0;
+  std::string_view m_line;
+  size_t m_linePosition = 0;
+  size_t m_lineNumber = 0;
+  size_t m_invalidCount = 0;
+  size_t m_firstInvalidLine = 0;
+
+  // Раскодированные строки текущей записи; deque не перемещает строки при добавлении
+  std::deque<std::string> m_unescaped;
+  size_t m_unescapedUsed = 0;
+};
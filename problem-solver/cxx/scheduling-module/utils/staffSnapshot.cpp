@@ -0,0 +1,223 @@
+#include "staffSnapshot.hpp"
+
+namespace
+{
+
+std::string_view const MAGIC = "STFS";
+size_t const CHECKSUM_SIZE = sizeof(uint64_t);
+
+uint64_t Checksum(std::string_view data)
+{
+  uint64_t hash = 14695981039346656037ull;
+  for (unsigned char const symbol : data)
+  {
+    hash ^= symbol;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+void WriteFixed(std::string & out, uint64_t value, size_t size)
+{
+  for (size_t i = 0; i < size; ++i)
+    out += static_cast<char>((value >> (8 * i)) & 0xFF);
+}
+
+void WriteNumber(std::string & out, uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    out += static_cast<char>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out += static_cast<char>(value);
+}
+
+void WriteString(std::string & out, std::string_view value)
+{
+  WriteNumber(out, value.size());
+  out += value;
+}
+
+void WriteIndices(std::string & out, std::vector<uint32_t> const & indices)
+{
+  WriteNumber(out, indices.size());
+  for (uint32_t const index : indices)
+    WriteNumber(out, index);
+}
+
+// Последовательное чтение с проверкой границ
+class SnapshotInput
+{
+public:
+  explicit SnapshotInput(std::string_view data)
+    : m_data(data)
+  {
+  }
+
+  bool ReadFixed(uint64_t & value, size_t size)
+  {
+    if (m_data.size() - m_position < size)
+      return false;
+    value = 0;
+    for (size_t i = 0; i < size; ++i)
+      value |= static_cast<uint64_t>(static_cast<unsigned char>(m_data[m_position++])) << (8 * i);
+    return true;
+  }
+
+  bool ReadNumber(uint64_t & value)
+  {
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && m_position < m_data.size(); shift += 7)
+    {
+      auto const byte = static_cast<unsigned char>(m_data[m_position++]);
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return true;
+    }
+    return false;
+  }
+
+  // Число элементов не может превышать остаток данных: каждый элемент занимает хотя бы байт
+  bool ReadCount(uint64_t & count)
+  {
+    return ReadNumber(count) && count <= m_data.size() - m_position;
+  }
+
+  bool ReadString(std::string & value)
+  {
+    uint64_t size = 0;
+    if (!ReadCount(size))
+      return false;
+    value.assign(m_data.data() + m_position, size);
+    m_position += size;
+    return true;
+  }
+
+  bool ReadIndices(std::vector<uint32_t> & indices, size_t limit)
+  {
+    uint64_t count = 0;
+    if (!ReadCount(count))
+      return false;
+    indices.resize(count);
+    for (uint32_t & index : indices)
+    {
+      uint64_t value = 0;
+      if (!ReadNumber(value) || value >= limit)
+        return false;
+      index = static_cast<uint32_t>(value);
+    }
+    return true;
+  }
+
+  bool ReadStrings(std::vector<std::string> & values)
+  {
+    uint64_t count = 0;
+    if (!ReadCount(count))
+      return false;
+    values.resize(count);
+    for (std::string & value : values)
+    {
+      if (!ReadString(value))
+        return false;
+    }
+    return true;
+  }
+
+  bool IsEnd() const
+  {
+    return m_position == m_data.size();
+  }
+
+private:
+  std::string_view m_data;
+  size_t m_position = 0;
+};
+
+}  // namespace
+
+std::string StaffSnapshotCodec::Encode(StaffSnapshot const & snapshot)
+{
+  std::string out;
+  out.reserve(64 + snapshot.employees.size() * 32);
+  out += MAGIC;
+  WriteFixed(out, VERSION, sizeof(VERSION));
+
+  WriteNumber(out, snapshot.professions.size());
+  for (auto const & profession : snapshot.professions)
+    WriteString(out, profession);
+  WriteNumber(out, snapshot.shifts.size());
+  for (auto const & shift : snapshot.shifts)
+    WriteString(out, shift);
+
+  WriteNumber(out, snapshot.employees.size());
+  for (auto const & employee : snapshot.employees)
+  {
+    WriteString(out, employee.id);
+    WriteString(out, employee.name);
+    WriteNumber(out, employee.profession);
+    WriteIndices(out, employee.allowedShifts);
+    WriteIndices(out, employee.forbiddenShifts);
+  }
+
+  WriteFixed(out, Checksum(out), CHECKSUM_SIZE);
+  return out;
+}
+
+bool StaffSnapshotCodec::Decode(std::string_view data, StaffSnapshot & snapshot, std::string & error)
+{
+  if (data.size() < MAGIC.size() + sizeof(VERSION) + CHECKSUM_SIZE || data.substr(0, MAGIC.size()) != MAGIC)
+  {
+    error = "not a staff snapshot";
+    return false;
+  }
+
+  std::string_view const body = data.substr(0, data.size() - CHECKSUM_SIZE);
+  uint64_t checksum = 0;
+  SnapshotInput(data.substr(body.size())).ReadFixed(checksum, CHECKSUM_SIZE);
+  if (checksum != Checksum(body))
+  {
+    error = "checksum mismatch";
+    return false;
+  }
+
+  SnapshotInput input(body.substr(MAGIC.size()));
+  uint64_t version = 0;
+  input.ReadFixed(version, sizeof(VERSION));
+  if (version == 0 || version > VERSION)
+  {
+    error = "unsupported snapshot version " + std::to_string(version);
+    return false;
+  }
+
+  snapshot = StaffSnapshot();
+  uint64_t employeeCount = 0;
+  if (!input.ReadStrings(snapshot.professions) || !input.ReadStrings(snapshot.shifts)
+      || !input.ReadCount(employeeCount))
+  {
+    error = "truncated dictionaries";
+    return false;
+  }
+
+  snapshot.employees.resize(employeeCount);
+  for (auto & employee : snapshot.employees)
+  {
+    uint64_t profession = 0;
+    if (!input.ReadString(employee.id) || !input.ReadString(employee.name) || !input.ReadNumber(profession)
+        || profession >= snapshot.professions.size()
+        || !input.ReadIndices(employee.allowedShifts, snapshot.shifts.size())
+        || !input.ReadIndices(employee.forbiddenShifts, snapshot.shifts.size()))
+    {
+      error = "invalid employee record";
+      return false;
+    }
+    employee.profession = static_cast<uint32_t>(profession);
+  }
+
+  if (!input.IsEnd())
+  {
+    error = "unexpected data after employees";
+    return false;
+  }
+  return true;
+}
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Сотрудник в снимке штата: профессия и смены — номера в словарях снимка
+struct StaffSnapshotEmployee
+{
+  std::string id;
+  std::string name;
+  uint32_t profession = 0;
+  std::vector<uint32_t> allowedShifts;
+  std::vector<uint32_t> forbiddenShifts;
+};
+
+// Снимок штата. Классы профессий и смен хранятся системными идентификаторами,
+// поэтому снимок переносится между экземплярами sc-machine
+struct StaffSnapshot
+{
+  std::vector<std::string> professions;
+  std::vector<std::string> shifts;
+  std::vector<StaffSnapshotEmployee> employees;
+};
+
+// Двоичный формат снимка: сигнатура, номер версии, словари, сотрудники и контрольная сумма FNV-1a.
+// Числа записываются в формате LEB128, строки — длиной и байтами
+class StaffSnapshotCodec
+{
+public:
+  static constexpr uint16_t VERSION = 1;
+
+  static std::string Encode(StaffSnapshot const & snapshot);
+
+  // false, если данные повреждены, обрезаны или записаны более новой версией; причина — в error
+  static bool Decode(std::string_view data, StaffSnapshot & snapshot, std::string & error);
+};